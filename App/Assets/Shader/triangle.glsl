@@ -2,9 +2,14 @@
 
 #version 420 core
 layout (location = 0) in vec3 a_Position;
-uniform mat4 u_ViewProjection;
+layout (std140, binding = 0) uniform Camera {
+	mat4 u_ViewProjection;
+};
+layout (std140, binding = 1) uniform Model {
+	mat4 u_Model;
+};
 void main() {
-	gl_Position = u_ViewProjection * vec4(a_Position, 1.0f);
+	gl_Position = u_ViewProjection * u_Model * vec4(a_Position, 1.0f);
 }
 
 #fragmentShader
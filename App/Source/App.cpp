@@ -1,8 +1,57 @@
 #include "Core/Core.h"
+#include "Core/SnapshotRenderer.h"
+#include "Math/Pure3DHullAlgos.h"
+#include "Math/Rng.h"
+#include <memory>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
 
+namespace {
 
-int main()
+	// App --snapshot <count> <number of points> <directory>
+	// Renders random hulls to PNG thumbnails without opening a window
+	int runSnapshots(int count, int numberOfPoints, const std::string& directory)
+	{
+		std::unique_ptr<Core::SnapshotRenderer> snapshot(Core::SnapshotRenderer::create(256, 256));
+		if (not snapshot)
+			return 1;
+		for (int i = 0; i < count; i++)
+		{
+			std::vector<Core::point3D<double>> p(numberOfPoints);
+			for (auto& point : p)
+				point = Core::point3D<double>(Core::Rng::Randfloat(-5, 5), Core::Rng::Randfloat(-5, 5), Core::Rng::Randfloat(-5, 5));
+			// Faces index the reordered input
+			auto hull = Core::ConvexHullMachine<double>::incrementalFast(p);
+
+			std::vector<glm::vec3> points;
+			points.reserve(p.size());
+			for (const auto& point : p)
+				points.emplace_back(float(point.x), float(point.y), float(point.z));
+			std::vector<Core::SnapshotRenderer::face_t> faces;
+			faces.reserve(hull.size());
+			for (const auto& face : hull)
+				faces.emplace_back(face.a, face.b, face.c);
+
+			snapshot->render(points, faces);
+			std::string path = directory + "/hull_" + std::to_string(i) + ".png";
+			if (not snapshot->save(path))
+			{
+				std::cout << "Could not write " << path << "\n";
+				return 1;
+			}
+		}
+		return 0;
+	}
+
+}
+
+int main(int argc, char** argv)
 {
+	if (argc == 5 && std::strcmp(argv[1], "--snapshot") == 0)
+		return runSnapshots(std::atoi(argv[2]), std::max(std::atoi(argv[3]), 4), argv[4]);
 	Core::CreateApplication()->run();
 	return 0;
 }
\ No newline at end of file
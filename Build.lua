@@ -14,4 +14,5 @@ group "Core"
 	include "Core/Build-Core.lua"
 group ""
 
-include "App/Build-App.lua"
\ No newline at end of file
+include "App/Build-App.lua"
+include "Tests/Build-Tests.lua"
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "Application.h"
+#include "Profiler.h"
 
 namespace Core {
 
@@ -20,8 +21,33 @@ namespace Core {
 	{
 		while (m_running)
 		{
+			CORE_PROFILE_SCOPE("Application::frame");
+			uint64_t eventCount = m_window->getEventCount();
+			if (m_settleFrames > 0)
+			{
+				m_window->pollEvents();
+				m_settleFrames--;
+			}
+			else if (isAnimating())
+			{
+				double timeout = getTimeToNextUpdate();
+				if (timeout > 0.0)
+					m_window->waitEvents(timeout);
+				else
+					m_window->pollEvents();
+			}
+			else
+			{
+				// Idle: no CPU until something happens
+				m_window->waitEvents();
+				m_settleFrames = s_settleFrames;
+			}
+			if (m_window->getEventCount() != eventCount)
+				m_settleFrames = s_settleFrames;
+			if (not m_running)
+				break;
 			onUpdate();
-			m_window->onUpdate();
+			m_window->swapBuffers();
 		}
 	}
 
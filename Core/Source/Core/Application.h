@@ -14,11 +14,19 @@ namespace Core {
 		
 		const std::unique_ptr<Window>& getWindow() const;
 		virtual void onUpdate() = 0;
+		// While true frames keep coming, otherwise run() sleeps until input arrives
+		virtual bool isAnimating() const { return false; }
+		// Seconds an animating frame may still wait for input, e.g. until the next scheduled step
+		virtual double getTimeToNextUpdate() const { return 0.0; }
 	private:
 		void onWindowClose();
 
 	private:
+		// Frames drawn after input so UI hover and release states settle before sleeping
+		static constexpr int s_settleFrames = 3;
+
 		std::unique_ptr<Window> m_window;
 		bool m_running = true;
+		int m_settleFrames = s_settleFrames;
 	};
 }
\ No newline at end of file
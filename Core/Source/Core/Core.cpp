@@ -1,8 +1,22 @@
 ﻿#include "Core.h"
+#include "Profiler.h"
 #include <glm/glm.hpp>
 
 namespace Core {
 
+	namespace {
+		// The visualizer's (x, y, z) is drawn as (y, z, x)
+		glm::mat4 visualizerToWorld()
+		{
+			return glm::mat4(
+				glm::vec4(0.0f, 0.0f, 1.0f, 0.0f),
+				glm::vec4(1.0f, 0.0f, 0.0f, 0.0f),
+				glm::vec4(0.0f, 1.0f, 0.0f, 0.0f),
+				glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)
+			);
+		}
+	}
+
 	Application* CreateApplication() {
 		return (Application*) new CoreApp();
 	}
@@ -10,15 +24,17 @@ namespace Core {
 	CoreApp::CoreApp()
 		: Application(),
 		m_camera(new Camera<CameraType::thirdPerson>()),
-		m_pointShader("Assets/Shader/point.glsl"),
-		m_triangleShader("Assets/Shader/triangle.glsl"),
-		m_lineShader("Assets/Shader/line.glsl")
+		m_pointShader(ShaderLibrary::load("Assets/Shader/point.glsl")),
+		m_triangleShader(ShaderLibrary::load("Assets/Shader/triangle.glsl")),
+		m_lineShader(ShaderLibrary::load("Assets/Shader/line.glsl"))
 	{
 		m_vertexArray = createRef<VertexArray>();
 		m_vertexArray->setIndexBuffer(createRef<IndexBuffer>(nullptr, 0));
 		m_OxyzRenderer = createRef<OxyzRenderer>(m_camera);
 		m_OxyzRenderer->setLineWidth(5);
 		m_OxyzRenderer->setPointSize(7);
+		m_lineColor = m_lineShader->getUniform<glm::vec4>("u_FragColor");
+		m_triangleColor = m_triangleShader->getUniform<glm::vec4>("u_FragColor");
 
 		eventSetup();
 
@@ -105,47 +121,77 @@ namespace Core {
 
 	void CoreApp::onUpdate()
 	{
-		onRender();
-		beginImGuiFrame();
-		onImGuiFrame();
-		endImGuiFrame();
+		m_performancePanel.beginFrame();
+		stepAlgorithm();
+		{
+			CpuPhaseScope phase(m_performancePanel, CpuPhase::Render);
+			onRender();
+		}
+		{
+			CpuPhaseScope phase(m_performancePanel, CpuPhase::ImGui);
+			beginImGuiFrame();
+			onImGuiFrame();
+			endImGuiFrame();
+		}
+	}
+
+	bool CoreApp::isAnimating() const
+	{
+		return m_vRunning && not m_paused && not m_finished;
+	}
+
+	double CoreApp::getTimeToNextUpdate() const
+	{
+		return m_scheduler.getTimeToNextStep(glfwGetTime());
+	}
+
+	void CoreApp::stepAlgorithm()
+	{
+		if (not isAnimating())
+		{
+			m_stepping = false;
+			return;
+		}
+		double now = glfwGetTime();
+		m_scheduler.setRate(m_speed);
+		if (not m_stepping)
+		{
+			// Started or resumed, time spent stopped does not count
+			m_scheduler.reset(now);
+			m_stepping = true;
+			return;
+		}
+		int steps = m_scheduler.advance(now);
+		for (int i = 0; i < steps && not m_finished; i++)
+		{
+			if (m_type == ConvexHullAlgoType::Incremental)
+			{
+				m_subStep = (m_subStep + 1) % s_incrementalSubSteps;
+				if (m_subStep == 1)
+					m_visualizer.clearVisibleFace();
+				if (m_subStep != 0)
+					continue;
+			}
+			CpuPhaseScope phase(m_performancePanel, CpuPhase::HullStep);
+			m_finished = not m_visualizer.nextState();
+		}
 	}
 
 	void CoreApp::onRender()
 	{
-		double currentFrame = glfwGetTime();
+		CORE_PROFILE_FUNCTION();
 		m_OxyzRenderer->setClearColor(glm::vec4(0.5f, 0.5f, 0.5f, 0.0f));
 		m_OxyzRenderer->clear();
+		m_OxyzRenderer->beginScene(m_camera->getVP());
 		m_OxyzRenderer->drawAxis();
 		if (m_vRunning)
 		{
-			if (not m_paused)
-			{
-				m_deltaTime += currentFrame - m_lastFrame;
-				if (m_type == ConvexHullAlgoType::GiftWrapping)
-				{
-					if (m_deltaTime > 1 / m_speed)
-					{
-						m_visualizer.nextState();
-						m_deltaTime = 0.0;
-					}
-				}
-				if (m_type == ConvexHullAlgoType::Incremental)
-				{
-					if (m_deltaTime > 4 / m_speed)
-					{
-						m_visualizer.nextState();
-						m_deltaTime = 0.0;
-					}
-				}
-			}
 			auto drawLine = [&](const std::vector<unsigned int>& indices)
 			{
 				if (indices.size() == 0ull)
 					return;
-				m_lineShader.bind();
-				m_lineShader.setUniformMat4f("u_ViewProjection", m_camera->getVP());
-				m_lineShader.setUniform4f("u_FragColor", 0.1f, 0.6f, 0.6f, 0.95f);
+				m_lineShader->bind();
+				m_lineShader->setUniform(m_lineColor, glm::vec4(0.1f, 0.6f, 0.6f, 0.95f));
 				m_vertexArray->setIndexBuffer(createRef<IndexBuffer>(&indices[0], (int)indices.size()));
 				m_OxyzRenderer->drawLines(m_vertexArray);
 			};
@@ -153,18 +199,37 @@ namespace Core {
 			{
 				if (indices.size() == 0ull)
 					return;
-				m_triangleShader.bind();
-				m_triangleShader.setUniformMat4f("u_ViewProjection", m_camera->getVP());
-				m_triangleShader.setUniform4f("u_FragColor", v0, v1, v2, v3);
+				m_triangleShader->bind();
+				m_triangleShader->setUniform(m_triangleColor, glm::vec4(v0, v1, v2, v3));
 				m_vertexArray->setIndexBuffer(createRef<IndexBuffer>(&indices[0], (int)indices.size()));
 				m_OxyzRenderer->drawTriangles(m_vertexArray);
 			};
+			// Hull vertices are always drawn, the rest of the cloud is thinned with distance
+			auto drawPoints = [&](std::vector<unsigned int> pinned)
+			{
+				std::sort(pinned.begin(), pinned.end());
+				pinned.erase(std::unique(pinned.begin(), pinned.end()), pinned.end());
+				if (pinned != m_pinnedPoints)
+				{
+					m_pinnedPoints = std::move(pinned);
+					m_pointLOD->setPinnedPoints(m_pinnedPoints.data(), (int)m_pinnedPoints.size());
+				}
+				m_pointShader->bind();
+				m_pointLOD->update(
+					m_camera->getVP() * visualizerToWorld(),
+					m_camera->getProjection()[1][1] * getWindow()->getHeight() * 0.5f
+				);
+				m_pointLOD->draw(*m_OxyzRenderer);
+			};
+			// m_vertexArray shares the lod's buffer, whose points are in lod order
+			auto toSlots = [&](std::vector<unsigned int>& indices)
+			{
+				for (unsigned int& index : indices)
+					index = m_pointLOD->getSlot(index);
+			};
 			std::vector<unsigned int> edges;
 			if (m_type == ConvexHullAlgoType::GiftWrapping)
 			{
-				m_pointShader.bind();
-				m_pointShader.setUniformMat4f("u_ViewProjection", m_camera->getVP());
-				m_OxyzRenderer->drawPoints(m_vertexArray, m_numberOfPoints);
 				std::vector<unsigned int> indices;
 				int count = m_visualizer.getCurrentIndex() + 1;
 				for (const auto& [a, b, c] : m_visualizer.getFaces()) 
@@ -181,6 +246,9 @@ namespace Core {
 					edges.push_back(c);
 					edges.push_back(a);
 				}
+				drawPoints(indices);
+				toSlots(indices);
+				toSlots(edges);
 				drawLine(edges);
 				drawFace(indices, 0.1f, 0.6f, 0.1f, 0.6f);
 			}
@@ -188,18 +256,10 @@ namespace Core {
 			{
 				int count = m_visualizer.getRemainFaceCount();
 				int pointCount = m_visualizer.getCurrentIndex();
-				if (m_deltaTime > 1 / m_speed)
-					m_visualizer.clearVisibleFace();
-				if (m_deltaTime > 2 / m_speed)
+				if (m_subStep >= 2)
 					count = (int)m_visualizer.getFaces().size();
-				if (m_deltaTime > 3 / m_speed)
+				if (m_subStep >= 3)
 					pointCount = std::min(m_numberOfPoints, pointCount + 1);
-				
-				m_vertexArray->bind();
-				m_vertexArray->setIndexBuffer(createRef<IndexBuffer>(&m_visualizer.getPointOrder()[0], pointCount));
-				m_pointShader.bind();
-				m_pointShader.setUniformMat4f("u_ViewProjection", m_camera->getVP());
-				m_OxyzRenderer->drawPoints(m_vertexArray);
 
 				std::vector<unsigned int> indices;
 				for (const auto& [a, b, c] : m_visualizer.getFaces()) 
@@ -229,16 +289,28 @@ namespace Core {
 					edges.push_back(c);
 					edges.push_back(a);
 				}
+				// Only the points inserted so far, a thinned cloud would show the ones still to come
+				std::vector<unsigned int> inserted(m_visualizer.getPointOrder().begin(), m_visualizer.getPointOrder().begin() + pointCount);
+				toSlots(inserted);
+				if (not inserted.empty())
+				{
+					m_vertexArray->setIndexBuffer(createRef<IndexBuffer>(inserted.data(), (int)inserted.size()));
+					m_pointShader->bind();
+					m_OxyzRenderer->drawPoints(m_vertexArray);
+				}
+				toSlots(indices);
+				toSlots(visibleFace);
+				toSlots(edges);
 				drawLine(edges);
 				drawFace(indices, 0.1f, 0.6f, 0.1f, 0.6f);
 				drawFace(visibleFace, 0.6f, 0.1f, 0.1f, 0.6f);
 			}
 		}
-		m_lastFrame = currentFrame;
 	}
 
 	void CoreApp::onImGuiFrame()
 	{
+		CORE_PROFILE_FUNCTION();
 		ImGui::Begin("Visualizer");
 
 		if (m_vRunning)
@@ -256,7 +328,7 @@ namespace Core {
 
 		ImGui::Text("Speed: ");
 		ImGui::SameLine();
-		ImGui::SliderFloat("##speed", &m_speed, 0.01f, 50.0f);
+		ImGui::SliderFloat("##speed", &m_speed, m_minSpeed, m_maxSpeed, "%.2f steps/s", ImGuiSliderFlags_Logarithmic);
 
 		if (not m_vRunning) {
 			if (ImGui::Button("Run"))
@@ -264,18 +336,16 @@ namespace Core {
 				if ((int)m_type != -1)
 				{
 					m_visualizer.reset(m_type, m_numberOfPoints);
-					std::vector<float> v;
-					for (glm::vec3 p : m_visualizer.getPoints())
-					{
-						v.push_back(p.y);
-						v.push_back(p.z);
-						v.push_back(p.x);
-					}
-					m_vertexArray->setVertexBuffer(createRef<VertexBuffer>(
-						&v[0],
-						sizeof(float) * 3 * m_numberOfPoints,
-						3                                         // position
-					));
+					// Quantized once into the lod's buffer, the shaders undo it through u_Model.
+					// Lines and faces draw from the same buffer through remapped indices
+					const auto& points = m_visualizer.getPoints();
+					QuantizationBounds bounds = QuantizationBounds::fromPoints(points.data(), points.size());
+					m_pointLOD = createRef<PointCloudLOD>(points.data(), points.size(), bounds, m_pointFormat);
+					m_vertexArray->setVertexBuffer(m_pointLOD->getVertexBuffer());
+					m_pinnedPoints.clear();
+					m_OxyzRenderer->setModelTransform(visualizerToWorld() * bounds.getDequantization());
+					m_subStep = 0;
+					m_finished = false;
 					m_vRunning = true;
 				}
 			}
@@ -296,7 +366,13 @@ namespace Core {
 		}
 
 		ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+#ifndef DIST
+		if (ImGui::Button("Save trace"))
+			Profiler::writeChromeTrace("trace.json");
+#endif // !DIST
 		ImGui::End();
+
+		m_performancePanel.draw(m_OxyzRenderer->getGpuTimer());
 	}
 
 	void CoreApp::beginImGuiFrame()
@@ -308,6 +384,7 @@ namespace Core {
 
 	void CoreApp::endImGuiFrame()
 	{
+		CORE_PROFILE_FUNCTION();
 		ImGuiIO& io = ImGui::GetIO();
 		//io.DisplaySize = ImVec2(getWindow()->getWidth(), getWindow()->getWidth());
 
@@ -5,9 +5,14 @@
 #include <imgui/imgui_impl_opengl3.h>
 #include "Renderer/VertexArray.h"
 #include "Renderer/Buffer.h"
+#include "Renderer/VertexFormat.h"
+#include "Renderer/PointCloudLOD.h"
 #include "Renderer/Shader.h"
+#include "Renderer/ShaderCache.h"
 #include "Renderer/Camera.h"
 #include "OxyzRenderer.h"
+#include "PerformancePanel.h"
+#include "FixedStepScheduler.h"
 #include "Math/ConvexHullAlgos.h"
 #include "Base.h"
 
@@ -22,29 +27,43 @@ namespace Core {
 		void eventSetup();
 
 		void onUpdate() override;
+		bool isAnimating() const override;
+		double getTimeToNextUpdate() const override;
+		void stepAlgorithm();
 		void onRender();
 		void onImGuiFrame();
 		void beginImGuiFrame();
 		void endImGuiFrame();
 	private:
-		double m_lastFrame = 0.0;
-		double m_deltaTime = 0.0;
-		float m_speed = 5.0f;
+		// Incremental shows every insertion in this many steps: visible faces, removal, new faces, new point
+		static constexpr int s_incrementalSubSteps = 4;
+
+		float m_speed = 5.0f;   // steps per second
 		const float m_minSpeed = 0.01f;
-		const float m_maxSpeed = 50.0f;
+		const float m_maxSpeed = 1000.0f;
+		FixedStepScheduler m_scheduler;
+		int m_subStep = 0;
+		bool m_stepping = false;
+		bool m_finished = false;
 		bool m_dragging = false;
 		bool m_dragStart = false;
 		double m_lastDragX = 0.0;
 		double m_lastDragY = 0.0;
 		Ref<VertexArray> m_vertexArray;
+		Ref<PointCloudLOD> m_pointLOD;
+		std::vector<unsigned int> m_pinnedPoints;  // sorted hull vertices last given to m_pointLOD
 		Ref<OxyzRenderer> m_OxyzRenderer;
 		Ref<Camera<CameraType::thirdPerson>> m_camera;
-		Shader m_pointShader;
-		Shader m_triangleShader;
-		Shader m_lineShader;
+		Ref<Shader> m_pointShader;
+		Ref<Shader> m_triangleShader;
+		Ref<Shader> m_lineShader;
+		Uniform<glm::vec4> m_lineColor;
+		Uniform<glm::vec4> m_triangleColor;
 		ConvexHullAlgos m_visualizer;
+		PerformancePanel m_performancePanel;
 		ConvexHullAlgoType m_type = ConvexHullAlgoType::none;
 		int m_numberOfPoints = 4;
+		VertexFormat m_pointFormat = VertexFormat::Snorm16x4;
 		bool m_vRunning = false;
 		bool m_paused = false;
 	};
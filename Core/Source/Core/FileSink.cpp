@@ -0,0 +1,63 @@
+#include "FileSink.h"
+#include <cstring>
+
+namespace Core {
+
+	FileSink::FileSink(const std::string& path, size_t bufferSize)
+		: m_buffer(bufferSize)
+	{
+		m_file = std::fopen(path.c_str(), "wb");
+		m_good = m_file != nullptr;
+	}
+
+	FileSink::~FileSink()
+	{
+		if (m_file)
+		{
+			flush();
+			std::fclose(m_file);
+		}
+	}
+
+	void FileSink::write(const void* data, size_t size)
+	{
+		m_written += size;
+		if (not m_good)
+			return;
+		if (m_used + size > m_buffer.size())
+		{
+			flush();
+			// Large blocks skip the buffer
+			if (size >= m_buffer.size())
+			{
+				m_good = std::fwrite(data, 1, size, m_file) == size;
+				return;
+			}
+		}
+		std::memcpy(m_buffer.data() + m_used, data, size);
+		m_used += size;
+	}
+
+	void FileSink::pad(size_t alignment)
+	{
+		static const char zeros[64] = {};
+		size_t remainder = size_t(m_written % alignment);
+		if (remainder == 0)
+			return;
+		for (size_t left = alignment - remainder; left > 0; )
+		{
+			size_t chunk = left < sizeof(zeros) ? left : sizeof(zeros);
+			write(zeros, chunk);
+			left -= chunk;
+		}
+	}
+
+	bool FileSink::flush()
+	{
+		if (m_good && m_used > 0)
+			m_good = std::fwrite(m_buffer.data(), 1, m_used, m_file) == m_used;
+		m_used = 0;
+		return m_good;
+	}
+
+}
\ No newline at end of file
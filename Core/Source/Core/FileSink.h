@@ -0,0 +1,42 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+
+namespace Core {
+
+	// Buffered binary output for the hull writers and exporters.
+	// Output is streamed, nothing but the buffer is held in memory.
+	class FileSink
+	{
+	public:
+		explicit FileSink(const std::string& path, size_t bufferSize = 1 << 16);
+		~FileSink();
+
+		FileSink(const FileSink&) = delete;
+		FileSink& operator=(const FileSink&) = delete;
+
+		void write(const void* data, size_t size);
+		template<typename T>
+		void writeValue(const T& value) { write(&value, sizeof(T)); }
+		void writeText(std::string_view text) { write(text.data(), text.size()); }
+		// Zero bytes up to the next multiple of `alignment`
+		void pad(size_t alignment);
+
+		// Bytes written so far
+		uint64_t tell() const { return m_written; }
+		// False once opening or any write failed
+		bool good() const { return m_good; }
+		bool flush();
+
+	private:
+		FILE* m_file = nullptr;
+		std::vector<char> m_buffer;
+		size_t m_used = 0;
+		uint64_t m_written = 0;
+		bool m_good = false;
+	};
+
+}
\ No newline at end of file
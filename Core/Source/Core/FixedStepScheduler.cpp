@@ -0,0 +1,48 @@
+#include "FixedStepScheduler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Core {
+
+	FixedStepScheduler::FixedStepScheduler(double stepsPerSecond, int maxSteps)
+		: m_stepTime(1.0 / stepsPerSecond), m_maxSteps(maxSteps)
+	{
+	}
+
+	void FixedStepScheduler::reset(double now)
+	{
+		m_nextStep = now + m_stepTime;
+		m_droppedSteps = 0;
+	}
+
+	int FixedStepScheduler::advance(double now)
+	{
+		if (now < m_nextStep)
+			return 0;
+		double due = std::floor((now - m_nextStep) / m_stepTime) + 1.0;
+		if (due > m_maxSteps)
+		{
+			m_droppedSteps += (long long)due - m_maxSteps;
+			m_nextStep = now + m_stepTime;
+			return m_maxSteps;
+		}
+		m_nextStep += due * m_stepTime;
+		return (int)due;
+	}
+
+	double FixedStepScheduler::getTimeToNextStep(double now) const
+	{
+		return std::max(m_nextStep - now, 0.0);
+	}
+
+	void FixedStepScheduler::setRate(double stepsPerSecond)
+	{
+		double stepTime = 1.0 / stepsPerSecond;
+		if (stepTime == m_stepTime)
+			return;
+		// Keep the progress made towards the pending step
+		m_nextStep += stepTime - m_stepTime;
+		m_stepTime = stepTime;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#pragma once
+
+namespace Core {
+
+	// Runs simulation steps at a fixed rate, independent of the frame rate.
+	// advance() returns how many steps are due, so fast rates take several steps in one frame.
+	// A frame never runs more than getMaxSteps() of them, the rest of the backlog is dropped
+	// instead of piling up after a stall.
+	class FixedStepScheduler
+	{
+	public:
+		FixedStepScheduler(double stepsPerSecond = 1.0, int maxSteps = 64);
+
+		// Starts counting from `now`, forgets any backlog
+		void reset(double now);
+		// Steps due since the last call
+		int advance(double now);
+		// Seconds until the next step is due
+		double getTimeToNextStep(double now) const;
+
+		void setRate(double stepsPerSecond);
+		double getRate() const { return 1.0 / m_stepTime; }
+		void setMaxSteps(int maxSteps) { m_maxSteps = maxSteps; }
+		int getMaxSteps() const { return m_maxSteps; }
+		// Steps dropped by the cap since reset()
+		long long getDroppedSteps() const { return m_droppedSteps; }
+
+	private:
+		double m_stepTime;
+		double m_nextStep = 0.0;
+		int m_maxSteps;
+		long long m_droppedSteps = 0;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+	// Read-only memory map of a whole file, mmap on POSIX and a file mapping on Windows.
+	// Pages are loaded on first touch, opening costs the same for any file size.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		bool open(const std::string& path);
+		void close();
+
+		bool isOpen() const { return m_data != nullptr; }
+		const uint8_t* getData() const { return m_data; }
+		size_t getSize() const { return m_size; }
+
+	private:
+		const uint8_t* m_data = nullptr;
+		size_t m_size = 0;
+#ifdef _WIN32
+		void* m_file = nullptr;
+		void* m_mapping = nullptr;
+#endif
+	};
+
+}
\ No newline at end of file
@@ -10,26 +10,39 @@ namespace Core {
 
     void OxyzRenderer::init()
     {
+        // Unit length axes, scaled in the vertex shader so the buffer never changes
+        float vertices[42] = {
+                // aPosition                // aColor
+            -1.0f, 0.0f,  0.0f,         0.0f, 1.0f, 0.0f, 1.0f,
+            1.0f,  0.0f,  0.0f,         0.0f, 1.0f, 0.0f, 1.0f,
+            0.0f,  -1.0f, 0.0f,         0.0f, 0.0f, 1.0f, 1.0f,
+            0.0f,  1.0f,  0.0f,         0.0f, 0.0f, 1.0f, 1.0f,
+            0.0f,  0.0f,  -1.0f,        1.0f, 0.0f, 0.0f, 1.0f,
+            0.0f,  0.0f,  1.0f,         1.0f, 0.0f, 0.0f, 1.0f,
+        };
         m_axis.reset(VertexArray::create());
-        auto axisBuf = createRef<VertexBuffer>(
-            sizeof(float) * 7 * (3 + 3),    // 6 vertices(3 lines)
+        m_axis->setVertexBuffer(createRef<VertexBuffer>(
+            vertices,
+            sizeof(vertices),               // 6 vertices(3 lines)
             3,                              // aPosition
             4                               // aColor
-        );
-        m_axis->setVertexBuffer(axisBuf);
+        ));
 
         const char* vAxisShader = R"(
 			#version 420 core
 			layout (location = 0) in vec3 aPos;
             layout (location = 1) in vec4 aColor;
 
-			uniform mat4 ViewProjection;
+			layout (std140, binding = 0) uniform Camera {
+				mat4 u_ViewProjection;
+			};
+			uniform float u_Scale;
             
             out vec4 axisColor;
 
 			void main()
 			{
-				gl_Position = ViewProjection * vec4(aPos, 1.0f);
+				gl_Position = u_ViewProjection * vec4(aPos * u_Scale, 1.0f);
                 axisColor = aColor;
 			}
 		)";
@@ -42,8 +55,18 @@ namespace Core {
 				FragColor = axisColor;
 			}
 		)";
-        m_axisShader = createRef<Shader>(vAxisShader, fAxisShader);
+        m_axisShader = ShaderLibrary::load(vAxisShader, fAxisShader);
+        m_axisScale = m_axisShader->getUniform<float>("u_Scale");
 
+        // Arrow head for a unit axis, pointing up the y axis
+        const float a = 0.01f;
+        float arrowVertices[15] = {
+            -a,     0.0f,       -a,
+            -a,     0.0f,       a,
+            a,      0.0f,       a,
+            a,      0.0f,       -a,
+            0.0f,   3.0f * a,  0.0f,
+        };
         unsigned int indices[15] = {
             0, 1, 4,
             1, 2, 4,
@@ -54,65 +77,80 @@ namespace Core {
         m_arrow.reset(VertexArray::create());
         m_arrow->setIndexBuffer(createRef<IndexBuffer>(
             indices,
-            int(sizeof(indices) / sizeof(float))
+            int(sizeof(indices) / sizeof(unsigned int))
         ));
         m_arrow->setVertexBuffer(createRef<VertexBuffer>(
-            sizeof(float) * 5 * 3,
+            arrowVertices,
+            sizeof(arrowVertices),
             3
         ));
-        m_arrowShader = createRef<Shader>("Assets/Shader/triangle.glsl");
+
+        // One instance per axis, the whole arrow set is scaled together with the axes
+        const char* vArrowShader = R"(
+			#version 420 core
+			layout (location = 0) in vec3 aPos;
+
+			layout (std140, binding = 0) uniform Camera {
+				mat4 u_ViewProjection;
+			};
+			uniform mat4 u_Model[3];
+			uniform vec4 u_Color[3];
+			uniform float u_Scale;
+
+			out vec4 arrowColor;
+
+			void main()
+			{
+				vec3 position = (u_Model[gl_InstanceID] * vec4(aPos, 1.0f)).xyz;
+				gl_Position = u_ViewProjection * vec4(position * u_Scale, 1.0f);
+				arrowColor = u_Color[gl_InstanceID];
+			}
+		)";
+        const char* fArrowShader = R"(
+			#version 420 core
+			in vec4 arrowColor;
+			out vec4 FragColor;
+			void main()
+			{
+				FragColor = arrowColor;
+			}
+		)";
+        m_arrowShader = ShaderLibrary::load(vArrowShader, fArrowShader);
+        m_arrowScale = m_arrowShader->getUniform<float>("u_Scale");
+
+        glm::mat4 models[3] = {
+            glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(1.0f, 0.0f, 0.0f)),
+                        glm::radians(-90.0f),
+                        glm::vec3(0.0f, 0.0f, 1.0f)),
+            glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 0.0f)),
+            glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, 1.0f)),
+                        glm::radians(90.0f),
+                        glm::vec3(1.0f, 0.0f, 0.0f)),
+        };
+        glm::vec4 colors[3] = {
+            glm::vec4(0.0f, 1.0f, 0.0f, 1.0f),
+            glm::vec4(0.0f, 0.0f, 1.0f, 1.0f),
+            glm::vec4(1.0f, 0.0f, 0.0f, 1.0f),
+        };
+        m_arrowShader->bind();
+        for (int i = 0; i < 3; i++)
+        {
+            m_arrowShader->setUniform(m_arrowShader->getUniform<glm::mat4>("u_Model[" + std::to_string(i) + "]"), models[i]);
+            m_arrowShader->setUniform(m_arrowShader->getUniform<glm::vec4>("u_Color[" + std::to_string(i) + "]"), colors[i]);
+        }
     }
 
     void OxyzRenderer::drawAxis()
     {
         float axisLen = glm::length(m_camera->getDirection()) * 0.5f;
-        {
-            float vertices[42] = {
-                    // aPosition                    // aColor
-                -axisLen, 0.0f,    0.0f,         0.0f, 1.0f, 0.0f, 1.0f,
-                axisLen,  0.0f,    0.0f,         0.0f, 1.0f, 0.0f, 1.0f,
-                0.0f,    -axisLen, 0.0f,         0.0f, 0.0f, 1.0f, 1.0f,
-                0.0f,    axisLen,  0.0f,         0.0f, 0.0f, 1.0f, 1.0f,
-                0.0f,    0.0f,    -axisLen,      1.0f, 0.0f, 0.0f, 1.0f,
-                0.0f,    0.0f,    axisLen,       1.0f, 0.0f, 0.0f, 1.0f,
-            };
-            m_axis->getVertexBuffer()->setBuffer(vertices, 42 * sizeof(float));
-            m_axisShader->bind();
-            m_axisShader->setUniformMat4f("ViewProjection", m_camera->getVP());
-            drawLines(m_axis, 36);
-        }
-        {
-            m_arrowShader->bind();
-            float a = axisLen * 0.01f;
-            float verticies[15] = {
-                -a,     0.0f,       -a,
-                -a,     0.0f,       a,
-                a,      0.0f,       a,
-                a,      0.0f,       -a,
-                0.0f,   3.0f * a,  0.0f,
-            };
-            m_arrow->getVertexBuffer()->setBuffer(verticies, sizeof(verticies));
-
-            glm::mat4 model;
-            model = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(axisLen, 0.0f, 0.0f)), 
-                                glm::radians(-90.0f), 
-                                glm::vec3(0.0f, 0.0f, 1.0f));
-            m_arrowShader->setUniform4f("u_FragColor", 0.0f, 1.0f, 0.0f, 1.0f);
-            m_arrowShader->setUniformMat4f("u_ViewProjection", m_camera->getVP() * model);
-            drawTriangles(m_arrow);
-
-            model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, axisLen, 0.0f));
-            m_arrowShader->setUniform4f("u_FragColor", 0.0f, 0.0f, 1.0f, 1.0f);
-            m_arrowShader->setUniformMat4f("u_ViewProjection", m_camera->getVP() * model);
-            drawTriangles(m_arrow);
-
-            model = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, axisLen)),
-                                glm::radians(90.0f),
-                                glm::vec3(1.0f, 0.0f, 0.0f));
-            m_arrowShader->setUniform4f("u_FragColor", 1.0f, 0.0f, 0.0f, 1.0f);
-            m_arrowShader->setUniformMat4f("u_ViewProjection", m_camera->getVP() * model);
-            drawTriangles(m_arrow);
-        }
+
+        m_axisShader->bind();
+        m_axisShader->setUniform(m_axisScale, axisLen);
+        drawLines(m_axis, 6);
+
+        m_arrowShader->bind();
+        m_arrowShader->setUniform(m_arrowScale, axisLen);
+        drawTrianglesInstanced(m_arrow, 3);
     }
 
 }
\ No newline at end of file
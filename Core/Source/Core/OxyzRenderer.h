@@ -3,6 +3,7 @@
 #include "Renderer/Camera.h"
 #include "Core/Base.h"
 #include "Renderer/Shader.h"
+#include "Renderer/ShaderCache.h"
 
 namespace Core {
 
@@ -19,6 +20,8 @@ namespace Core {
 		Ref<VertexArray> m_arrow;
 		Ref<Shader> m_axisShader;
 		Ref<Shader> m_arrowShader;
+		Uniform<float> m_axisScale;
+		Uniform<float> m_arrowScale;
 		Ref<Camera<CameraType::thirdPerson>> m_camera;
 	};
 
@@ -0,0 +1,87 @@
+#include "PerformancePanel.h"
+#include "Renderer/Buffer.h"
+#include <imgui/imgui.h>
+#include <algorithm>
+
+namespace Core {
+
+	PerformancePanel::PerformancePanel()
+		: m_frameTimes(s_historySize, 0.0f), m_lastFrame(Clock::now())
+	{
+		m_sorted.reserve(s_historySize);
+	}
+
+	void PerformancePanel::beginFrame()
+	{
+		Clock::time_point now = Clock::now();
+		std::chrono::duration<float, std::milli> frameTime = now - m_lastFrame;
+		m_lastFrame = now;
+		m_frameTimes[m_frameIndex] = frameTime.count();
+		m_frameIndex = (m_frameIndex + 1) % s_historySize;
+		m_frameCount = std::min(m_frameCount + 1, s_historySize);
+
+		// Publish the finished frame's counters, then start a new one
+		std::copy(std::begin(m_phaseTime), std::end(m_phaseTime), std::begin(m_lastPhaseTime));
+		std::fill(std::begin(m_phaseTime), std::end(m_phaseTime), 0.0);
+		m_lastHullSteps = m_hullSteps;
+		m_hullSteps = 0;
+		m_lastUploads = BufferStats::uploads;
+		m_lastUploadBytes = BufferStats::bytes;
+		BufferStats::reset();
+	}
+
+	void PerformancePanel::addPhaseTime(CpuPhase phase, double ms)
+	{
+		m_phaseTime[(int)phase] += ms;
+		if (phase == CpuPhase::HullStep)
+		{
+			m_hullSteps++;
+			m_maxHullStep = std::max(m_maxHullStep, ms);
+		}
+	}
+
+	void PerformancePanel::draw(const GpuTimer& gpuTimer)
+	{
+		ImGui::Begin("Performance");
+
+		m_sorted.assign(m_frameTimes.begin(), m_frameTimes.begin() + m_frameCount);
+		auto percentile = [this](float p) {
+			if (m_sorted.empty())
+				return 0.0f;
+			auto nth = m_sorted.begin() + std::min((size_t)(p * m_sorted.size()), m_sorted.size() - 1);
+			std::nth_element(m_sorted.begin(), nth, m_sorted.end());
+			return *nth;
+		};
+		float p50 = percentile(0.50f);
+		float p95 = percentile(0.95f);
+		float p99 = percentile(0.99f);
+		float worst = m_sorted.empty() ? 0.0f : *std::max_element(m_sorted.begin(), m_sorted.end());
+
+		ImGui::PlotHistogram("##frame times", m_frameTimes.data(), s_historySize, m_frameIndex,
+			"frame time (ms)", 0.0f, std::max(33.4f, worst), ImVec2(0.0f, 80.0f));
+		ImGui::Text("p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  max %.2f ms", p50, p95, p99, worst);
+
+		ImGui::SeparatorText("CPU");
+		ImGui::Text("Render      %.3f ms", m_lastPhaseTime[(int)CpuPhase::Render]);
+		ImGui::Text("Hull step   %.3f ms (%d steps, worst %.3f ms)",
+			m_lastPhaseTime[(int)CpuPhase::HullStep], m_lastHullSteps, m_maxHullStep);
+		ImGui::Text("ImGui       %.3f ms", m_lastPhaseTime[(int)CpuPhase::ImGui]);
+
+		ImGui::SeparatorText("GPU");
+		const char* passNames[(int)GpuPass::Count] = { "Points", "Lines", "Triangles" };
+		for (int pass = 0; pass < (int)GpuPass::Count; pass++)
+		{
+			ImGui::Text("%-11s %.3f ms (%d draws)", passNames[pass],
+				gpuTimer.getPassTime((GpuPass)pass), gpuTimer.getDrawCount((GpuPass)pass));
+		}
+
+		ImGui::SeparatorText("Uploads");
+		ImGui::Text("%llu buffers, %.1f KiB per frame",
+			(unsigned long long)m_lastUploads, m_lastUploadBytes / 1024.0);
+		if (ImGui::Button("Reset worst hull step"))
+			m_maxHullStep = 0.0;
+
+		ImGui::End();
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <vector>
+#include "Renderer/GpuTimer.h"
+
+namespace Core {
+
+	enum class CpuPhase
+	{
+		Render, HullStep, ImGui, Count
+	};
+
+	// ImGui window with a rolling frame time history, percentiles, CPU time per phase,
+	// GPU time per pass and buffer upload traffic
+	class PerformancePanel
+	{
+	public:
+		static constexpr int s_historySize = 256;
+
+		PerformancePanel();
+
+		// Call once per frame, before any phase is timed
+		void beginFrame();
+		void addPhaseTime(CpuPhase phase, double ms);
+		void draw(const GpuTimer& gpuTimer);
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		std::vector<float> m_frameTimes;
+		std::vector<float> m_sorted;
+		int m_frameIndex = 0;
+		int m_frameCount = 0;
+		Clock::time_point m_lastFrame;
+
+		double m_phaseTime[(int)CpuPhase::Count] = {};
+		double m_lastPhaseTime[(int)CpuPhase::Count] = {};
+		int m_hullSteps = 0;
+		int m_lastHullSteps = 0;
+		double m_maxHullStep = 0.0;
+		uint64_t m_lastUploads = 0;
+		uint64_t m_lastUploadBytes = 0;
+	};
+
+	class CpuPhaseScope
+	{
+	public:
+		CpuPhaseScope(PerformancePanel& panel, CpuPhase phase)
+			: m_panel(panel), m_phase(phase), m_start(std::chrono::steady_clock::now()) {}
+		~CpuPhaseScope()
+		{
+			std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_start;
+			m_panel.addPhaseTime(m_phase, elapsed.count());
+		}
+
+	private:
+		PerformancePanel& m_panel;
+		CpuPhase m_phase;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "Profiler.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Core {
+
+	namespace {
+		struct ThreadBuffer
+		{
+			uint32_t threadId;
+			std::vector<Profiler::Event> events;
+			std::atomic<uint64_t> written{ 0 };
+		};
+
+		// Buffers are never freed, so events of finished threads can still be exported
+		struct Registry
+		{
+			std::mutex mutex;
+			std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+			const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+		};
+
+		Registry& getRegistry()
+		{
+			static Registry registry;
+			return registry;
+		}
+
+		ThreadBuffer& getThreadBuffer()
+		{
+			thread_local ThreadBuffer* buffer = [] {
+				Registry& registry = getRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+				auto created = std::make_unique<ThreadBuffer>();
+				created->threadId = (uint32_t)registry.buffers.size();
+				created->events.resize(Profiler::s_eventsPerThread);
+				registry.buffers.push_back(std::move(created));
+				return registry.buffers.back().get();
+			}();
+			return *buffer;
+		}
+
+		void writeEscaped(FILE* file, const char* text)
+		{
+			for (; *text; text++)
+			{
+				if (*text == '"' || *text == '\\')
+					std::fputc('\\', file);
+				std::fputc(*text, file);
+			}
+		}
+	}
+
+	uint64_t Profiler::now()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - getRegistry().epoch).count();
+	}
+
+	void Profiler::record(const char* name, uint64_t start, uint64_t end)
+	{
+		ThreadBuffer& buffer = getThreadBuffer();
+		uint64_t written = buffer.written.load(std::memory_order_relaxed);
+		buffer.events[written % s_eventsPerThread] = { name, start, end - start };
+		buffer.written.store(written + 1, std::memory_order_release);
+	}
+
+	void Profiler::clear()
+	{
+		Registry& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		for (auto& buffer : registry.buffers)
+			buffer->written.store(0, std::memory_order_release);
+	}
+
+	bool Profiler::writeChromeTrace(const std::string& path)
+	{
+		FILE* file = std::fopen(path.c_str(), "w");
+		if (file == nullptr)
+			return false;
+
+		Registry& registry = getRegistry();
+		std::lock_guard<std::mutex> lock(registry.mutex);
+		std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+		bool first = true;
+		for (const auto& buffer : registry.buffers)
+		{
+			uint64_t written = buffer->written.load(std::memory_order_acquire);
+			uint64_t begin = written > s_eventsPerThread ? written - s_eventsPerThread : 0;
+			for (uint64_t i = begin; i < written; i++)
+			{
+				const Event& event = buffer->events[i % s_eventsPerThread];
+				std::fputs(first ? "\n" : ",\n", file);
+				first = false;
+				std::fputs("{\"ph\":\"X\",\"cat\":\"cpu\",\"name\":\"", file);
+				writeEscaped(file, event.name);
+				std::fprintf(file, "\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+					buffer->threadId, event.start / 1000.0, event.duration / 1000.0);
+			}
+		}
+		std::fputs("\n]}\n", file);
+		return std::fclose(file) == 0;
+	}
+
+}
\ No newline at end of file
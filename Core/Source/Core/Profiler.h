@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+namespace Core {
+
+	// Low overhead scoped CPU profiler.
+	// Every thread records complete events into its own fixed size ring buffer (the oldest
+	// events get overwritten), writeChromeTrace() dumps them as Chrome trace / Perfetto JSON.
+	// Use the CORE_PROFILE_* macros, they compile to nothing in Dist builds.
+	class Profiler
+	{
+	public:
+		struct Event
+		{
+			const char* name;   // not copied, string literals or __FUNCTION__
+			uint64_t start;     // ns since the profiler started
+			uint64_t duration;  // ns
+		};
+
+		static uint64_t now();
+		static void record(const char* name, uint64_t start, uint64_t end);
+		static void clear();
+		// Call while the profiled threads are idle, events recorded meanwhile may be torn
+		static bool writeChromeTrace(const std::string& path);
+
+		static constexpr size_t s_eventsPerThread = 1 << 16;
+	};
+
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(const char* name) : m_name(name), m_start(Profiler::now()) {}
+		~ProfileScope() { Profiler::record(m_name, m_start, Profiler::now()); }
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		const char* m_name;
+		uint64_t m_start;
+	};
+
+}
+
+#ifndef DIST
+#define CORE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CORE_PROFILE_CONCAT(a, b) CORE_PROFILE_CONCAT_IMPL(a, b)
+#define CORE_PROFILE_SCOPE(name) ::Core::ProfileScope CORE_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define CORE_PROFILE_FUNCTION() CORE_PROFILE_SCOPE(__FUNCTION__)
+#else
+#define CORE_PROFILE_SCOPE(name)
+#define CORE_PROFILE_FUNCTION()
+#endif // !DIST
\ No newline at end of file
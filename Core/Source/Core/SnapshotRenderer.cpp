@@ -0,0 +1,112 @@
+#include "SnapshotRenderer.h"
+#include "Renderer/ShaderCache.h"
+#include "Renderer/PngWriter.h"
+#include "Profiler.h"
+#include <algorithm>
+
+namespace Core {
+
+	SnapshotRenderer* SnapshotRenderer::create(int width, int height, int samples)
+	{
+		std::unique_ptr<Window> window(Window::CreateHeadless(width, height));
+		if (not window)
+			return nullptr;
+		return new SnapshotRenderer(std::move(window), samples);
+	}
+
+	SnapshotRenderer::SnapshotRenderer(std::unique_ptr<Window> window, int samples)
+		: m_window(std::move(window)),
+		m_pointShader(ShaderLibrary::load("Assets/Shader/point.glsl")),
+		m_triangleShader(ShaderLibrary::load("Assets/Shader/triangle.glsl")),
+		m_lineShader(ShaderLibrary::load("Assets/Shader/line.glsl"))
+	{
+		m_framebuffer = createRef<Framebuffer>(m_window->getWidth(), m_window->getHeight(), samples);
+		m_renderer = createRef<Renderer>();
+		m_renderer->setPointSize(3.0f);
+		m_renderer->setLineWidth(1.5f);
+		m_vertexArray = createRef<VertexArray>();
+		m_triangleColorUniform = m_triangleShader->getUniform<glm::vec4>("u_FragColor");
+		m_lineColorUniform = m_lineShader->getUniform<glm::vec4>("u_FragColor");
+		m_camera.setAspect(float(m_window->getWidth()) / m_window->getHeight());
+	}
+
+	SnapshotRenderer::~SnapshotRenderer()
+	{
+		// GL objects go before the context
+		m_vertexArray.reset();
+		m_renderer.reset();
+		m_framebuffer.reset();
+		m_pointShader.reset();
+		m_triangleShader.reset();
+		m_lineShader.reset();
+		m_window->shutDown();
+	}
+
+	void SnapshotRenderer::render(const std::vector<glm::vec3>& points, const std::vector<face_t>& faces)
+	{
+		CORE_PROFILE_FUNCTION();
+		if (points.empty())
+			return;
+		QuantizationBounds bounds = QuantizationBounds::fromPoints(points.data(), points.size());
+		auto vertexBuffer = createRef<VertexBuffer>(
+			nullptr,
+			getVertexSize(m_pointFormat) * points.size(),
+			BufferLayout{ getPositionElement(m_pointFormat) }   // position
+		);
+		quantizePositions(m_pointFormat, points.data(), points.size(), bounds, vertexBuffer->map());
+		vertexBuffer->unmap();
+		m_vertexArray->setVertexBuffer(vertexBuffer);
+
+		// Bounding sphere seen from the same corner as the interactive camera
+		float radius = std::max(glm::length(bounds.extent), 1e-6f);
+		float distance = radius / std::sin(glm::radians(45.0f) * 0.5f);
+		m_camera.setCenter(bounds.center);
+		m_camera.setPosition(bounds.center + glm::normalize(glm::vec3(1.0f)) * distance);
+		m_camera.setZNear(std::max(distance - radius, distance * 1e-3f));
+		m_camera.setZFar(distance + radius);
+
+		m_framebuffer->bind();
+		m_renderer->setClearColor(m_clearColor);
+		m_renderer->clear();
+		m_renderer->beginScene(m_camera.getVP());
+		m_renderer->setModelTransform(bounds.getDequantization());
+
+		std::vector<unsigned int> pointOrder(points.size());
+		for (unsigned int i = 0; i < pointOrder.size(); i++)
+			pointOrder[i] = i;
+		m_vertexArray->setIndexBuffer(createRef<IndexBuffer>(pointOrder.data(), (int)pointOrder.size()));
+		m_pointShader->bind();
+		m_renderer->drawPoints(m_vertexArray);
+
+		if (not faces.empty())
+		{
+			std::vector<unsigned int> indices;
+			std::vector<unsigned int> edges;
+			indices.reserve(faces.size() * 3);
+			edges.reserve(faces.size() * 6);
+			for (const auto& [a, b, c] : faces)
+			{
+				indices.insert(indices.end(), { (unsigned)a, (unsigned)b, (unsigned)c });
+				edges.insert(edges.end(), { (unsigned)a, (unsigned)b, (unsigned)b, (unsigned)c, (unsigned)c, (unsigned)a });
+			}
+			m_lineShader->bind();
+			m_lineShader->setUniform(m_lineColorUniform, m_lineColor);
+			m_vertexArray->setIndexBuffer(createRef<IndexBuffer>(edges.data(), (int)edges.size()));
+			m_renderer->drawLines(m_vertexArray);
+
+			m_triangleShader->bind();
+			m_triangleShader->setUniform(m_triangleColorUniform, m_faceColor);
+			m_vertexArray->setIndexBuffer(createRef<IndexBuffer>(indices.data(), (int)indices.size()));
+			m_renderer->drawTriangles(m_vertexArray);
+		}
+		m_framebuffer->unbind();
+	}
+
+	bool SnapshotRenderer::save(const std::string& path) const
+	{
+		CORE_PROFILE_FUNCTION();
+		std::vector<uint8_t> pixels = m_framebuffer->readPixels();
+		return writePng(path, m_framebuffer->getWidth(), m_framebuffer->getHeight(), 4, pixels.data());
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <tuple>
+#include <memory>
+#include <glm/glm.hpp>
+#include "Window.h"
+#include "Renderer/Renderer.h"
+#include "Renderer/Framebuffer.h"
+#include "Renderer/Shader.h"
+#include "Renderer/Camera.h"
+#include "Renderer/VertexFormat.h"
+#include "Base.h"
+
+namespace Core {
+
+	// Renders hull thumbnails without a display: headless context, no vsync, no ImGui.
+	// Draws into a multisampled framebuffer and saves it as PNG.
+	//
+	// How to use:
+	// auto snapshot = SnapshotRenderer::create(256, 256);
+	// snapshot->render(points, faces);
+	// snapshot->save("hull.png");
+	class SnapshotRenderer
+	{
+	public:
+		using face_t = std::tuple<int, int, int>;
+
+		// nullptr when no OpenGL context is available
+		static SnapshotRenderer* create(int width, int height, int samples = 4);
+
+		SnapshotRenderer(std::unique_ptr<Window> window, int samples);
+		~SnapshotRenderer();
+
+		// Camera is framed around the points, faces index into them
+		void render(const std::vector<glm::vec3>& points, const std::vector<face_t>& faces);
+		std::vector<uint8_t> readPixels() const { return m_framebuffer->readPixels(); }
+		bool save(const std::string& path) const;
+
+		void setClearColor(const glm::vec4& color) { m_clearColor = color; }
+		void setFaceColor(const glm::vec4& color) { m_faceColor = color; }
+		void setLineColor(const glm::vec4& color) { m_lineColor = color; }
+
+	private:
+		std::unique_ptr<Window> m_window;
+		Ref<Framebuffer> m_framebuffer;
+		Ref<Renderer> m_renderer;
+		Ref<VertexArray> m_vertexArray;
+		Ref<Shader> m_pointShader;
+		Ref<Shader> m_triangleShader;
+		Ref<Shader> m_lineShader;
+		Uniform<glm::vec4> m_triangleColorUniform;
+		Uniform<glm::vec4> m_lineColorUniform;
+		Camera<CameraType::thirdPerson> m_camera;
+		VertexFormat m_pointFormat = VertexFormat::Snorm16x4;
+		glm::vec4 m_clearColor = glm::vec4(0.5f, 0.5f, 0.5f, 1.0f);
+		glm::vec4 m_faceColor = glm::vec4(0.1f, 0.6f, 0.1f, 0.6f);
+		glm::vec4 m_lineColor = glm::vec4(0.1f, 0.6f, 0.6f, 0.95f);
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include <algorithm>
+
+namespace Core {
+
+	ThreadPool::ThreadPool(int threadCount)
+	{
+		if (threadCount <= 0)
+			threadCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+		for (int i = 0; i < threadCount; i++)
+			m_threads.emplace_back(&ThreadPool::workerLoop, this, i + 1);
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+		for (auto& thread : m_threads)
+			thread.join();
+	}
+
+	void ThreadPool::parallelFor(size_t count, size_t grain, const Job& job)
+	{
+		CORE_PROFILE_FUNCTION();
+		if (count == 0)
+			return;
+		grain = std::max<size_t>(grain, 1);
+		// Not worth waking anyone for a single chunk
+		if (count <= grain || m_threads.empty())
+		{
+			job(0, count, 0);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_job = &job;
+			m_count = count;
+			m_grain = grain;
+			m_next = 0;
+			m_busy = (int)m_threads.size();
+			m_generation++;
+		}
+		m_wake.notify_all();
+		runChunks(0);
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done.wait(lock, [this] { return m_busy == 0; });
+		m_job = nullptr;
+	}
+
+	void ThreadPool::workerLoop(int worker)
+	{
+		uint64_t seen = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+				if (m_stop)
+					return;
+				seen = m_generation;
+			}
+			runChunks(worker);
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (--m_busy == 0)
+					m_done.notify_one();
+			}
+		}
+	}
+
+	void ThreadPool::runChunks(int worker)
+	{
+		for (;;)
+		{
+			size_t begin = m_next.fetch_add(m_grain);
+			if (begin >= m_count)
+				return;
+			(*m_job)(begin, std::min(begin + m_grain, m_count), worker);
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+namespace Core {
+
+	// Fixed set of worker threads for data parallel loops.
+	// parallelFor() hands out chunks of the range through an atomic counter and the
+	// calling thread takes chunks too, so worker indices run from 0 to getWorkerCount() - 1.
+	// One loop runs at a time, parallelFor() is not reentrant.
+	class ThreadPool
+	{
+	public:
+		using Job = std::function<void(size_t begin, size_t end, int worker)>;
+
+		// 0 threads: one less than the hardware threads, the caller is the last one
+		explicit ThreadPool(int threadCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// Runs job over [0, count) in chunks of at most `grain` and returns when all of them are done
+		void parallelFor(size_t count, size_t grain, const Job& job);
+
+		int getWorkerCount() const { return (int)m_threads.size() + 1; }
+
+	private:
+		void workerLoop(int worker);
+		void runChunks(int worker);
+
+	private:
+		std::vector<std::thread> m_threads;
+		std::mutex m_mutex;
+		std::condition_variable m_wake;
+		std::condition_variable m_done;
+
+		const Job* m_job = nullptr;
+		size_t m_count = 0;
+		size_t m_grain = 1;
+		std::atomic<size_t> m_next = 0;
+		int m_busy = 0;
+		uint64_t m_generation = 0;
+		bool m_stop = false;
+	};
+
+}
\ No newline at end of file
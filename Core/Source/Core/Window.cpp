@@ -1,4 +1,5 @@
 #include "Window.h"
+#include "Profiler.h"
 #include <cassert>
 #include <iostream>
 
@@ -7,6 +8,7 @@
 
 namespace Core {
 
+	uint64_t Dispatcher::s_eventCount = 0;
 	CallbackFn0 Dispatcher::s_windowCloseCallback = nullptr;
 	CallbackFn3i Dispatcher::s_mouseButtonCallback = nullptr;
 	CallbackFn2d Dispatcher::s_cursorPosCallback = nullptr;
@@ -19,10 +21,24 @@ namespace Core {
 		return new Window(width, height, title);
 	}
 
-	Window::Window(int width, int height, const std::string& title)
-		:m_title(title), m_width(width), m_height(height)
+	Window* Window::CreateHeadless(int width, int height)
 	{
-		init(width, height, title);
+		Window* window = new Window(width, height, "Headless", true);
+		if (window->m_window == nullptr)
+		{
+			delete window;
+			return nullptr;
+		}
+		return window;
+	}
+
+	Window::Window(int width, int height, const std::string& title, bool headless)
+		:m_title(title), m_width(width), m_height(height), m_headless(headless)
+	{
+		if (headless)
+			initHeadless(width, height);
+		else
+			init(width, height, title);
 	}
 
 	void Window::init(int width, int height, const std::string& title)
@@ -37,13 +53,76 @@ namespace Core {
 		m_window = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
 		glfwMakeContextCurrent(m_window);
 		glfwSwapInterval(1); // 60fps
+		loadGL();
+	}
+
+	void Window::initHeadless(int width, int height)
+	{
+		// Surfaceless first so software rasterizers work without a display,
+		// then a hidden window on the native platform
+		struct Backend { int platform; int contextApi; };
+		constexpr Backend backends[] = {
+			{ GLFW_PLATFORM_NULL, GLFW_OSMESA_CONTEXT_API },
+			{ GLFW_ANY_PLATFORM, GLFW_EGL_CONTEXT_API },
+			{ GLFW_ANY_PLATFORM, GLFW_NATIVE_CONTEXT_API },
+		};
+		m_window = nullptr;
+		for (const auto& backend : backends)
+		{
+			if (s_glfwInitialized)
+			{
+				glfwTerminate();
+				s_glfwInitialized = false;
+			}
+			glfwInitHint(GLFW_PLATFORM, backend.platform);
+			if (not glfwInit())
+				continue;
+			s_glfwInitialized = true;
+			glfwDefaultWindowHints();
+			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+			glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+			glfwWindowHint(GLFW_CONTEXT_CREATION_API, backend.contextApi);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+			glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+			glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+			m_window = glfwCreateWindow(width, height, "Headless", nullptr, nullptr);
+			if (m_window)
+				break;
+		}
+		if (m_window == nullptr)
+		{
+			std::cout << "Could not create a headless OpenGL context!\n";
+			return;
+		}
+		glfwMakeContextCurrent(m_window);
+		glfwSwapInterval(0); // Batch rendering, never wait for vsync
+		loadGL();
+	}
+
+	void Window::loadGL()
+	{
 		int status = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 		assert(status && "Failed to initialize Glad!");
 	}
 
-	void Window::onUpdate()
+	void Window::pollEvents()
 	{
+		CORE_PROFILE_FUNCTION();
 		glfwPollEvents();
+	}
+
+	void Window::waitEvents(double timeout)
+	{
+		CORE_PROFILE_FUNCTION();
+		if (timeout < 0.0)
+			glfwWaitEvents();
+		else
+			glfwWaitEventsTimeout(timeout);
+	}
+
+	void Window::swapBuffers()
+	{
+		CORE_PROFILE_FUNCTION();
 		glfwSwapBuffers(m_window);
 	}
 
@@ -51,6 +130,7 @@ namespace Core {
 	{
 		glfwDestroyWindow(m_window);
 		glfwTerminate();
+		s_glfwInitialized = false;
 	}
 
 	void Window::setWindowCloseCallback(const CallbackFn0& callback)
@@ -3,6 +3,7 @@
 #include <GLFW/glfw3.h>
 #include <string>
 #include <functional>
+#include <cstdint>
 #include <imgui/imgui.h>
 #include <imgui/imgui_impl_glfw.h>
 #include <imgui/imgui_impl_opengl3.h>
@@ -22,33 +23,41 @@ namespace Core {
 
 	struct Dispatcher
 	{
+		// Input events seen so far, tells the idle loop that something happened
+		static uint64_t s_eventCount;
+
 		static CallbackFn0 s_windowCloseCallback;
 		static void windowCloseCallback(GLFWwindow* window) 
 		{
+			s_eventCount++;
 			s_windowCloseCallback();
 		}
 
 		static CallbackFn3i s_mouseButtonCallback;
 		static void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) 
 		{
+			s_eventCount++;
 			s_mouseButtonCallback(button, action, mods);
 		}
 
 		static CallbackFn2d s_cursorPosCallback;
 		static void cursorPosCallback(GLFWwindow* window, double xpos, double ypos) 
 		{
+			s_eventCount++;
 			s_cursorPosCallback(xpos, ypos);
 		}
 
 		static CallbackFn2d s_scrollCallback;
 		static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset) 
 		{
+			s_eventCount++;
 			s_scrollCallback(xoffset, yoffset);
 		}
 
 		static CallbackFn4i s_keyCallback;
 		static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) 
 		{
+			s_eventCount++;
 			s_keyCallback(key, scancode, action, mods);
 		}
 	};
@@ -58,10 +67,16 @@ namespace Core {
 	{
 	public:
 		static Window* Create(int width = 1600, int height = 900, const std::string& title = "Window");
+		// Invisible window without vsync for offscreen rendering, prefers a surfaceless
+		// OSMesa/EGL context so it also runs without a display. nullptr when no context could be made
+		static Window* CreateHeadless(int width, int height);
 	public:
 
-		Window(int width, int height, const std::string& title);
-		void onUpdate();
+		Window(int width, int height, const std::string& title, bool headless = false);
+		void pollEvents();
+		// Blocks until an event arrives, or at most `timeout` seconds when it is not negative
+		void waitEvents(double timeout = -1.0);
+		void swapBuffers();
 		void shutDown();
 		// Params: empty
 		void setWindowCloseCallback(const CallbackFn0& callback);
@@ -77,15 +92,20 @@ namespace Core {
 		int getWidth() const { return m_width; }
 		int getHeight() const { return m_height; }
 		GLFWwindow* getNativeWindow() const { return m_window; }
+		bool isHeadless() const { return m_headless; }
+		uint64_t getEventCount() const { return Dispatcher::s_eventCount; }
 
 	private:
 		void init(int width, int height, const std::string& title);
+		void initHeadless(int width, int height);
+		void loadGL();
 
 	private:
 		GLFWwindow* m_window;
 		std::string m_title;
 		int m_width;
 		int m_height;
+		bool m_headless = false;
 	};
 
 }
\ No newline at end of file
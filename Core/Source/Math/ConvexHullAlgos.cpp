@@ -1,10 +1,12 @@
 #include "ConvexHullAlgos.h"
+#include "Core/Profiler.h"
 
 namespace Core {
 
 	
 	void ConvexHullAlgos::reset(ConvexHullAlgoType type, int numberOfPoints)
 	{
+		CORE_PROFILE_FUNCTION();
 		m_currentIndex = 0;
 		m_edges.clear();
 		m_faces.clear();
@@ -41,6 +43,7 @@ namespace Core {
 
 	bool ConvexHullAlgos::nextFace()
 	{
+		CORE_PROFILE_FUNCTION();
 		if (m_currentIndex == (int)m_faces.size()) {
 			return false;
 		}
@@ -94,6 +97,7 @@ namespace Core {
 
 	bool ConvexHullAlgos::nextPoints()
 	{
+		CORE_PROFILE_FUNCTION();
 		m_visibleFaces.clear();
 		if (m_currentIndex == (int)m_points.size())
 		{
@@ -128,6 +132,7 @@ namespace Core {
 
 	void ConvexHullAlgos::initialFace()
 	{
+		CORE_PROFILE_FUNCTION();
 		int n = (int)m_points.size();
 		
 		std::sort(m_ord.begin(), m_ord.end(),
@@ -196,6 +201,7 @@ namespace Core {
 
 	void ConvexHullAlgos::initialTetrahedron()
 	{
+		CORE_PROFILE_FUNCTION();
 		int n = (int)m_points.size();
 
 		glm::vec3 p0 = m_points[m_ord[0]];
@@ -254,7 +260,7 @@ namespace Core {
 	glm::vec3 ConvexHullAlgos::normalVector(const face_t& face)
 	{
 		const auto& [a, b, c] = face;
-		return glm::cross(m_points[b] - m_points[a], m_points[c] - m_points[b]);
+		return toGlm(Core::normalVector(point3D<float>(m_points[a]), point3D<float>(m_points[b]), point3D<float>(m_points[c])));
 	}
 
 	bool ConvexHullAlgos::isZero(const glm::vec3& v)
@@ -273,7 +279,7 @@ namespace Core {
 
 	bool ConvexHullAlgos::canSee(const face_t& face, const glm::vec3& point)
 	{
-		return glm::dot(point - m_points[std::get<0>(face)], normalVector(face)) > s_EPS;
+		return dotFrom(point3D<float>(point), point3D<float>(m_points[std::get<0>(face)]), point3D<float>(normalVector(face))) > s_EPS;
 	}
 
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <glm/glm.hpp>
 #include "Math/Rng.h"
+#include "Math/Point3D.h"
 #include <cassert>
 
 namespace Core {
@@ -0,0 +1,143 @@
+// 2D Delaunay triangulation as the lower hull of the points lifted to a paraboloid
+#pragma once
+
+#include <vector>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+
+#include "Point3D.h"
+#include "Pure3DHullAlgos.h"
+
+namespace Core {
+
+    template<typename T>
+    struct point2D {
+        T x, y;
+    };
+
+    // Indices into the input points, counter-clockwise
+    struct DelaunayTriangle {
+        uint32_t a, b, c;
+    };
+
+    /*
+    * Lifts (x, y) to (x, y, x^2 + y^2) and hulls them with ConvexHullMachine::incrementalFast,
+    * the faces seen from below project to the Delaunay triangles.
+    *
+    * An apex far above the points takes the place of the upper hull:
+    * it sees every upper face, so the hull keeps one fan from the apex to the 2D boundary
+    * instead of a second triangulation. Points are centered and scaled to about unit spacing
+    * first, which keeps the engine's absolute epsilon meaningful at any input scale.
+    *
+    * Duplicate points are reported once, under their first index.
+    * Fewer than three distinct points or all of them collinear give no triangles.
+    *
+    * How to use:
+    * auto triangles = delaunay2D(std::span<const point2D<double>>(points));
+    */
+    template<typename T, typename Statistics = NoHullStatistics>
+    std::vector<DelaunayTriangle> delaunay2D(std::span<const point2D<T>> points, Statistics& stats) {
+        CORE_PROFILE_FUNCTION();
+        using point_t = point3D<T>;
+        std::vector<DelaunayTriangle> triangles;
+        size_t n = points.size();
+        if (n < 3) {
+            return triangles;
+        }
+
+        T minX = points[0].x, maxX = points[0].x, minY = points[0].y, maxY = points[0].y;
+        for (const auto& q : points) {
+            minX = std::min(minX, q.x);
+            maxX = std::max(maxX, q.x);
+            minY = std::min(minY, q.y);
+            maxY = std::max(maxY, q.y);
+        }
+        // The engine compares orientations with an absolute epsilon and a lifted tetrahedron of
+        // neighbors has a volume of about spacing^4, so the points are scaled to a spacing near 1
+        T area = (maxX - minX) * (maxY - minY);
+        if (!(area > 0)) {
+            return triangles;
+        }
+        T cx = (minX + maxX) / 2, cy = (minY + maxY) / 2;
+        T scale = std::sqrt(T(n) / area);
+
+        // Lifted points sorted by (x, y): deduplicates and finds a point again after the engine reorders them
+        struct Lifted {
+            point_t p;
+            uint32_t index;
+        };
+        std::vector<Lifted> lifted;
+        lifted.reserve(n);
+        T top = 0;
+        for (size_t i = 0; i < n; i++) {
+            T x = (points[i].x - cx) * scale, y = (points[i].y - cy) * scale;
+            lifted.push_back({ point_t(x, y, x * x + y * y), uint32_t(i) });
+            top = std::max(top, x * x + y * y);
+        }
+        auto byXY = [](const Lifted& lhs, const Lifted& rhs) {
+            return std::tie(lhs.p.x, lhs.p.y, lhs.index) < std::tie(rhs.p.x, rhs.p.y, rhs.index);
+            };
+        std::sort(lifted.begin(), lifted.end(), byXY);
+        lifted.erase(std::unique(lifted.begin(), lifted.end(), [](const Lifted& lhs, const Lifted& rhs) {
+            return lhs.p.x == rhs.p.x && lhs.p.y == rhs.p.y;
+            }), lifted.end());
+
+        // The engine asserts on coplanar input, and collinear points lift to a vertical plane through the apex
+        constexpr T epsilon = static_cast<T>(1e-9);
+        const point_t& first = lifted.front().p;
+        const point_t& last = lifted.back().p;
+        bool collinear = true;
+        for (const auto& l : lifted) {
+            T side = (last.x - first.x) * (l.p.y - first.y) - (last.y - first.y) * (l.p.x - first.x);
+            if (std::abs(side) > epsilon) {
+                collinear = false;
+                break;
+            }
+        }
+        if (lifted.size() < 3 || collinear) {
+            return triangles;
+        }
+
+        // A lower face is lost only when its plane passes above the apex at the center,
+        // which takes a circumcircle about 1 / sqrt(epsilon) times wider than the points
+        T apexHeight = (top + 1) / std::sqrt(std::numeric_limits<T>::epsilon());
+        point_t apex(0, 0, apexHeight);
+        std::vector<point_t> p;
+        p.reserve(lifted.size() + 1);
+        for (const auto& l : lifted) {
+            p.push_back(l.p);
+        }
+        p.push_back(apex);
+
+        auto faces = ConvexHullMachine<T, epsilon, Statistics>::incrementalFast(p, stats);
+
+        auto original = [&](const point_t& q) {
+            auto it = std::lower_bound(lifted.begin(), lifted.end(), q, [](const Lifted& l, const point_t& key) {
+                return std::tie(l.p.x, l.p.y) < std::tie(key.x, key.y);
+                });
+            return it->index;
+            };
+        std::vector<uint32_t> indices(p.size());
+        for (size_t i = 0; i < p.size(); i++) {
+            indices[i] = p[i] == apex ? uint32_t(-1) : original(p[i]);
+        }
+
+        triangles.reserve(faces.size());
+        for (const auto& f : faces) {
+            if (f.n.z >= 0 || p[f.a] == apex || p[f.b] == apex || p[f.c] == apex) {
+                continue;
+            }
+            // Counter-clockwise from below is clockwise in the plane
+            triangles.push_back({ indices[f.a], indices[f.c], indices[f.b] });
+        }
+        return triangles;
+    }
+
+    template<typename T>
+    std::vector<DelaunayTriangle> delaunay2D(std::span<const point2D<T>> points) {
+        NoHullStatistics stats;
+        return delaunay2D(points, stats);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,1084 @@
+// Convex hull in D dimensions by quickhull
+#pragma once
+
+#include <vector>
+#include <array>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <cassert>
+#include <memory>
+
+#include "Point3D.h"
+#include "Pure3DHullAlgos.h"
+#include "HullStatistics.h"
+#include "Core/Profiler.h"
+
+namespace Core {
+
+    // Normal of the hyperplane through D points, dot(normal, x - v[0]) is the signed volume of v and x
+    template<int D, typename T>
+    struct HullKernel;
+
+    template<typename T>
+    struct HullKernel<2, T> {
+        using point_t = std::array<T, 2>;
+
+        static std::array<T, 2> normal(const point_t* const v[2]) {
+            T dx = (*v[1])[0] - (*v[0])[0], dy = (*v[1])[1] - (*v[0])[1];
+            return { dy, -dx };
+        }
+    };
+
+    template<typename T>
+    struct HullKernel<3, T> {
+        using point_t = std::array<T, 3>;
+
+        static std::array<T, 3> normal(const point_t* const v[3]) {
+            const point_t& a = *v[0];
+            T ux = (*v[1])[0] - a[0], uy = (*v[1])[1] - a[1], uz = (*v[1])[2] - a[2];
+            T vx = (*v[2])[0] - a[0], vy = (*v[2])[1] - a[1], vz = (*v[2])[2] - a[2];
+            return { uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx };
+        }
+    };
+
+    template<typename T>
+    struct HullKernel<4, T> {
+        using point_t = std::array<T, 4>;
+
+        // Cofactors of the last row of det[e1; e2; e3; x]
+        static std::array<T, 4> normal(const point_t* const v[4]) {
+            const point_t& a = *v[0];
+            T e[3][4];
+            for (int r = 0; r < 3; r++) {
+                for (int c = 0; c < 4; c++) {
+                    e[r][c] = (*v[r + 1])[c] - a[c];
+                }
+            }
+            // 2x2 minors of the last two rows
+            T m01 = e[1][0] * e[2][1] - e[1][1] * e[2][0];
+            T m02 = e[1][0] * e[2][2] - e[1][2] * e[2][0];
+            T m03 = e[1][0] * e[2][3] - e[1][3] * e[2][0];
+            T m12 = e[1][1] * e[2][2] - e[1][2] * e[2][1];
+            T m13 = e[1][1] * e[2][3] - e[1][3] * e[2][1];
+            T m23 = e[1][2] * e[2][3] - e[1][3] * e[2][2];
+            return {
+                -(e[0][1] * m23 - e[0][2] * m13 + e[0][3] * m12),
+                e[0][0] * m23 - e[0][2] * m03 + e[0][3] * m02,
+                -(e[0][0] * m13 - e[0][1] * m03 + e[0][3] * m01),
+                e[0][0] * m12 - e[0][1] * m02 + e[0][2] * m01
+            };
+        }
+    };
+
+    /*
+    * Quickhull in D = 2, 3 or 4 dimensions. Facets are simplices with their neighbors
+    * stored next to their vertices, a facet only ever looks at its own outside points.
+    *
+    * Points within epsilon of a facet count as inside, so the hull keeps no coplanar vertices.
+    * The buffers stay allocated between builds, a reused Hull stops allocating once warm.
+    *
+    * How to use:
+    * Hull<4, double> hull;
+    * if (hull.build(points)) {
+    *     for (const auto& facet : hull.facets()) { facet.vertices, facet.neighbors, facet.normal ... }
+    * }
+    */
+    template<int D, typename T, typename Statistics = NoHullStatistics>
+    class Hull {
+        static_assert(D >= 2 && D <= 4, "Hull supports 2, 3 and 4 dimensions");
+    public:
+        using point_t = std::array<T, D>;
+        using index_t = std::array<uint32_t, D>;
+
+        static constexpr uint32_t none = 0xFFFFFFFFu;
+
+        struct Facet {
+            index_t vertices;           // indices into the input
+            index_t neighbors;          // neighbors[i] shares every vertex but vertices[i]
+            point_t normal;             // unit, pointing outwards
+            T offset;                   // dot(normal, x) + offset is the signed distance of x
+        };
+
+        // False when the points do not span D dimensions
+        bool build(std::span<const point_t> points) {
+            Statistics stats;
+            return build(points, stats);
+        }
+
+        bool build(std::span<const point_t> points, Statistics& stats) {
+            CORE_PROFILE_FUNCTION();
+            m_points = points;
+            m_result.clear();
+            m_facets.clear();
+            m_furthest.clear();
+            m_furthestDistance.clear();
+            m_pending.clear();
+            m_alive.clear();
+            m_visit.clear();
+            m_stamp = 0;
+            m_witness.assign(points.size(), 0);
+
+            stats.beginPhase(HullPhase::Setup);
+            std::array<uint32_t, D + 1> simplex;
+            if (!initialSimplex(simplex, stats)) {
+                return false;
+            }
+            m_interior = {};
+            for (uint32_t v : simplex) {
+                for (int k = 0; k < D; k++) {
+                    m_interior[k] += m_points[v][k] / (D + 1);
+                }
+            }
+            for (int i = 0; i <= D; i++) {
+                index_t vertices;
+                for (int j = 0, s = 0; j <= D; j++) {
+                    if (j != i) {
+                        vertices[s++] = simplex[j];
+                    }
+                }
+                addFacet(vertices, stats);
+            }
+            // Facet i lacks simplex[i], so the neighbor opposite simplex[j] is facet j
+            for (int i = 0; i <= D; i++) {
+                for (int s = 0; s < D; s++) {
+                    uint32_t v = m_facets[i].vertices[s];
+                    m_facets[i].neighbors[s] = uint32_t(std::find(simplex.begin(), simplex.end(), v) - simplex.begin());
+                }
+            }
+
+            {
+                CORE_PROFILE_SCOPE("Hull::initialConflicts");
+                stats.beginPhase(HullPhase::Conflicts);
+                m_candidates.clear();
+                for (uint32_t i = 0; i < uint32_t(m_points.size()); i++) {
+                    if (std::find(simplex.begin(), simplex.end(), i) == simplex.end()) {
+                        m_candidates.push_back(i);
+                    }
+                }
+                m_created.clear();
+                for (int i = 0; i <= D; i++) {
+                    m_created.push_back(uint32_t(i));
+                }
+                assign(stats);
+            }
+
+            runPending(stats);
+            collect(stats);
+            return true;
+        }
+
+        // Takes the points of the 3D engines, facet vertices index 'points'
+        bool build(const std::vector<point3D<T>>& points) requires (D == 3) {
+            Statistics stats;
+            return build(points, stats);
+        }
+
+        bool build(const std::vector<point3D<T>>& points, Statistics& stats) requires (D == 3) {
+            m_converted.resize(points.size());
+            for (size_t i = 0; i < points.size(); i++) {
+                m_converted[i] = { points[i].x, points[i].y, points[i].z };
+            }
+            return build(std::span<const point_t>(m_converted), stats);
+        }
+
+        const std::vector<Facet>& facets() const {
+            return m_result;
+        }
+
+        /*
+        * Moves the points of the last build to new positions, same count and same indices.
+        * Planes are refreshed in place and the vertices of ridges that stopped being convex
+        * are cut out with the facets around them, points that left the hull, these vertices
+        * included, are found by climbing from their facet of the last frame and inserted. Falls back to build() when more than
+        * getRebuildFraction() of the facets broke or touch a bad vertex, or when a patch does not close convexly
+        * around the interior point.
+        */
+        bool update(std::span<const point_t> points) {
+            Statistics stats;
+            return update(points, stats);
+        }
+
+        bool update(std::span<const point_t> points, Statistics& stats) {
+            CORE_PROFILE_FUNCTION();
+            m_report = {};
+            if (m_result.empty() || points.size() != m_witness.size()) {
+                m_report.rebuilt = true;
+                return build(points, stats);
+            }
+            m_points = points;
+            stats.beginPhase(HullPhase::Setup);
+            T scale = 0;
+            for (const auto& q : m_points) {
+                for (int k = 0; k < D; k++) {
+                    scale = std::max(scale, std::abs(q[k]));
+                }
+            }
+            m_epsilon = 8 * D * std::numeric_limits<T>::epsilon() * scale;
+
+            // Last frame's topology with planes through the new positions
+            size_t count = m_result.size();
+            m_facets.assign(m_result.begin(), m_result.end());
+            m_alive.assign(count, 1);
+            m_visit.assign(count, 0);
+            m_stamp = 0;
+            m_furthest.assign(count, none);
+            m_furthestDistance.assign(count, 0);
+            m_pending.clear();
+            if (m_outside.size() < count) {
+                m_outside.resize(count);
+            }
+            for (size_t f = 0; f < count; f++) {
+                m_outside[f].clear();
+            }
+            markVertices();
+            m_interior = {};
+            for (uint32_t v : m_hullVertices) {
+                for (int k = 0; k < D; k++) {
+                    m_interior[k] += m_points[v][k];
+                }
+            }
+            for (int k = 0; k < D; k++) {
+                m_interior[k] /= T(m_hullVertices.size());
+            }
+            for (auto& facet : m_facets) {
+                setPlane(facet);
+            }
+
+            // A facet breaks when it turned over or a neighbor's far vertex rose above it
+            m_badStamp++;
+            for (uint32_t f = 0; f < uint32_t(count); f++) {
+                const Facet& facet = m_facets[f];
+                bool broken = false;
+                stats.orientationTest();
+                if (distance(facet, m_interior) > -m_epsilon) {
+                    broken = true;
+                    for (uint32_t v : facet.vertices) {
+                        m_bad[v] = m_badStamp;
+                    }
+                }
+                for (int s = 0; s < D; s++) {
+                    stats.orientationTest();
+                    if (distance(facet, m_points[opposite(f, s)]) > m_epsilon) {
+                        broken = true;
+                        for (int j = 0; j < D; j++) {
+                            if (j != s) {
+                                m_bad[facet.vertices[j]] = m_badStamp;
+                            }
+                        }
+                    }
+                }
+                m_report.brokenFacets += broken;
+            }
+            if (m_report.brokenFacets > m_rebuildFraction * T(count) || (m_report.brokenFacets > 0 && !repair(stats))) {
+                m_report.rebuilt = true;
+                return build(points, stats);
+            }
+
+            // Points that left the hull, the climb starts from last frame's answer
+            stats.beginPhase(HullPhase::Conflicts);
+            markVertices();
+            uint32_t any = uint32_t(std::find(m_alive.begin(), m_alive.end(), 1) - m_alive.begin());
+            for (uint32_t q = 0; q < uint32_t(m_points.size()); q++) {
+                if (m_vertexMark[q] == m_vertexStamp) {
+                    continue;
+                }
+                uint32_t f = m_witness[q] < m_facets.size() && m_alive[m_witness[q]] ? m_witness[q] : any;
+                f = climb(m_points[q], f, stats);
+                m_witness[q] = f;
+                T d = distance(m_facets[f], m_points[q]);
+                if (d > m_epsilon) {
+                    m_report.insertedPoints++;
+                    stats.conflictUpdate();
+                    if (m_outside[f].empty()) {
+                        m_pending.push_back(f);
+                    }
+                    m_outside[f].push_back(q);
+                    if (d > m_furthestDistance[f]) {
+                        m_furthestDistance[f] = d;
+                        m_furthest[f] = q;
+                    }
+                }
+            }
+            runPending(stats);
+            collect(stats);
+            return true;
+        }
+
+        bool update(const std::vector<point3D<T>>& points) requires (D == 3) {
+            Statistics stats;
+            return update(points, stats);
+        }
+
+        bool update(const std::vector<point3D<T>>& points, Statistics& stats) requires (D == 3) {
+            m_converted.resize(points.size());
+            for (size_t i = 0; i < points.size(); i++) {
+                m_converted[i] = { points[i].x, points[i].y, points[i].z };
+            }
+            return update(std::span<const point_t>(m_converted), stats);
+        }
+
+        struct UpdateReport {
+            bool rebuilt = false;           // fell back to build()
+            size_t brokenFacets = 0;        // turned over or lost convexity at a ridge
+            size_t repairedFacets = 0;      // replaced by the local repair
+            size_t insertedPoints = 0;      // found outside the refreshed hull
+        };
+
+        const UpdateReport& getLastUpdate() const {
+            return m_report;
+        }
+
+        void setRebuildFraction(T fraction) {
+            m_rebuildFraction = fraction;
+        }
+
+        T getRebuildFraction() const {
+            return m_rebuildFraction;
+        }
+
+        // Sorted indices of the hull vertices
+        std::vector<uint32_t> vertices() const {
+            std::vector<uint32_t> result;
+            result.reserve(m_result.size() * D);
+            for (const auto& facet : m_result) {
+                result.insert(result.end(), facet.vertices.begin(), facet.vertices.end());
+            }
+            std::sort(result.begin(), result.end());
+            result.erase(std::unique(result.begin(), result.end()), result.end());
+            return result;
+        }
+
+        // Faces in the layout of ConvexHullMachine, counter-clockwise seen from outside
+        std::vector<Tface<T>> faces() const requires (D == 3) {
+            std::vector<Tface<T>> result;
+            result.reserve(m_result.size());
+            for (const auto& facet : m_result) {
+                point3D<T> n(facet.normal[0], facet.normal[1], facet.normal[2]);
+                result.emplace_back(facet.vertices[0], facet.vertices[1], facet.vertices[2], n, facet.offset);
+            }
+            return result;
+        }
+
+    private:
+        T distance(const Facet& facet, const point_t& p) const {
+            T result = facet.offset;
+            for (int k = 0; k < D; k++) {
+                result += facet.normal[k] * p[k];
+            }
+            return result;
+        }
+
+        // Extremes of the widest axis, then repeatedly the point farthest from the span so far
+        bool initialSimplex(std::array<uint32_t, D + 1>& simplex, Statistics& stats) {
+            size_t n = m_points.size();
+            if (n < D + 1) {
+                return false;
+            }
+            point_t lo = m_points[0], hi = m_points[0];
+            std::array<uint32_t, D> loIndex = {}, hiIndex = {};
+            for (uint32_t i = 0; i < uint32_t(n); i++) {
+                for (int k = 0; k < D; k++) {
+                    if (m_points[i][k] < lo[k]) {
+                        lo[k] = m_points[i][k];
+                        loIndex[k] = i;
+                    }
+                    if (m_points[i][k] > hi[k]) {
+                        hi[k] = m_points[i][k];
+                        hiIndex[k] = i;
+                    }
+                }
+            }
+            int axis = 0;
+            T scale = 0;
+            for (int k = 0; k < D; k++) {
+                if (hi[k] - lo[k] > hi[axis] - lo[axis]) {
+                    axis = k;
+                }
+                scale = std::max({ scale, std::abs(lo[k]), std::abs(hi[k]) });
+            }
+            m_epsilon = 8 * D * std::numeric_limits<T>::epsilon() * scale;
+            if (!(hi[axis] - lo[axis] > m_epsilon)) {
+                return false;
+            }
+            simplex[0] = loIndex[axis];
+            simplex[1] = hiIndex[axis];
+
+            // Orthonormal basis of the directions spanned so far
+            std::array<point_t, D> basis;
+            const point_t& origin = m_points[simplex[0]];
+            auto residual = [&](uint32_t i, int count) {
+                point_t v;
+                for (int k = 0; k < D; k++) {
+                    v[k] = m_points[i][k] - origin[k];
+                }
+                for (int b = 0; b < count; b++) {
+                    T projection = 0;
+                    for (int k = 0; k < D; k++) {
+                        projection += v[k] * basis[b][k];
+                    }
+                    for (int k = 0; k < D; k++) {
+                        v[k] -= projection * basis[b][k];
+                    }
+                }
+                return v;
+                };
+            auto length = [](const point_t& v) {
+                T result = 0;
+                for (int k = 0; k < D; k++) {
+                    result += v[k] * v[k];
+                }
+                return std::sqrt(result);
+                };
+            for (int s = 1; s <= D; s++) {
+                if (s > 1) {
+                    T best = 0;
+                    for (uint32_t i = 0; i < uint32_t(n); i++) {
+                        T l = length(residual(i, s - 1));
+                        if (l > best) {
+                            best = l;
+                            simplex[s] = i;
+                        }
+                    }
+                    stats.orientationTest(n);
+                    if (!(best > m_epsilon)) {
+                        return false;
+                    }
+                }
+                point_t v = residual(simplex[s], s - 1);
+                T l = length(v);
+                for (int k = 0; k < D; k++) {
+                    basis[s - 1][k] = v[k] / l;
+                }
+            }
+            return true;
+        }
+
+        // Plane through the vertices in their order, the normal follows HullKernel's orientation
+        void setPlane(Facet& facet) const {
+            const point_t* v[D];
+            for (int k = 0; k < D; k++) {
+                v[k] = &m_points[facet.vertices[k]];
+            }
+            facet.normal = HullKernel<D, T>::normal(v);
+            T l = 0;
+            for (int k = 0; k < D; k++) {
+                l += facet.normal[k] * facet.normal[k];
+            }
+            l = std::sqrt(l);
+            if (l > 0) {
+                for (int k = 0; k < D; k++) {
+                    facet.normal[k] /= l;
+                }
+            }
+            facet.offset = 0;
+            for (int k = 0; k < D; k++) {
+                facet.offset -= facet.normal[k] * (*v[0])[k];
+            }
+        }
+
+        // Plane of 'vertices' oriented away from the interior point, swapping two vertices if needed
+        uint32_t addFacet(index_t vertices, Statistics& stats) {
+            Facet facet;
+            facet.vertices = vertices;
+            setPlane(facet);
+            stats.orientationTest();
+            if (distance(facet, m_interior) > 0) {
+                std::swap(vertices[0], vertices[1]);
+                for (int k = 0; k < D; k++) {
+                    facet.normal[k] = -facet.normal[k];
+                }
+                facet.offset = -facet.offset;
+            }
+            facet.vertices = vertices;
+            facet.neighbors.fill(none);
+
+            uint32_t id = uint32_t(m_facets.size());
+            stats.faceCreated();
+            stats.growth(m_facets);
+            m_facets.push_back(facet);
+            m_alive.push_back(1);
+            m_visit.push_back(0);
+            m_furthest.push_back(none);
+            m_furthestDistance.push_back(0);
+            if (m_outside.size() < m_facets.size()) {
+                m_outside.emplace_back();
+            }
+            m_outside[id].clear();
+            return id;
+        }
+
+        void runPending(Statistics& stats) {
+            CORE_PROFILE_SCOPE("Hull::insert");
+            stats.beginPhase(HullPhase::Insertion);
+            while (!m_pending.empty()) {
+                uint32_t f = m_pending.back();
+                m_pending.pop_back();
+                if (m_alive[f] && !m_outside[f].empty()) {
+                    insert(f, stats);
+                }
+            }
+        }
+
+        void collect(Statistics& stats) {
+            CORE_PROFILE_SCOPE("Hull::collect");
+            stats.beginPhase(HullPhase::Output);
+            m_result.clear();
+            m_remap.assign(m_facets.size(), none);
+            for (uint32_t f = 0; f < uint32_t(m_facets.size()); f++) {
+                if (m_alive[f]) {
+                    m_remap[f] = uint32_t(m_result.size());
+                    m_result.push_back(m_facets[f]);
+                }
+            }
+            for (auto& facet : m_result) {
+                for (auto& neighbor : facet.neighbors) {
+                    neighbor = m_remap[neighbor];
+                }
+            }
+            // Facets of the next update are numbered like m_result
+            m_witness.resize(m_points.size(), 0);
+            for (auto& witness : m_witness) {
+                witness = witness < m_remap.size() && m_remap[witness] != none ? m_remap[witness] : 0;
+            }
+        }
+
+        // m_vertexMark[v] == m_vertexStamp for the vertices of the alive facets, listed in m_hullVertices
+        void markVertices() {
+            m_vertexMark.resize(m_points.size(), 0);
+            m_bad.resize(m_points.size(), 0);
+            m_vertexStamp++;
+            m_hullVertices.clear();
+            for (uint32_t f = 0; f < uint32_t(m_facets.size()); f++) {
+                if (!m_alive[f]) {
+                    continue;
+                }
+                for (uint32_t v : m_facets[f].vertices) {
+                    if (m_vertexMark[v] != m_vertexStamp) {
+                        m_vertexMark[v] = m_vertexStamp;
+                        m_hullVertices.push_back(v);
+                    }
+                }
+            }
+        }
+
+        // Vertex of the neighbor across slot 's' that is not on facet f
+        uint32_t opposite(uint32_t f, int s) const {
+            const Facet& neighbor = m_facets[m_facets[f].neighbors[s]];
+            for (int t = 0; t < D; t++) {
+                if (neighbor.neighbors[t] == f) {
+                    return neighbor.vertices[t];
+                }
+            }
+            return neighbor.vertices[0];
+        }
+
+        /*
+        * Facet with the largest distance(q) / depth, depth being how far the interior point is below it.
+        * Seen from the interior point that ratio is a linear function on the polar polytope, whose
+        * vertices are the facets and whose edges are their ridges, so climbing finds the global
+        * maximum and q is outside the hull exactly when that facet sees it.
+        */
+        uint32_t climb(const point_t& q, uint32_t f, Statistics& stats) const {
+            auto ratio = [&](uint32_t g) {
+                const Facet& facet = m_facets[g];
+                return distance(facet, q) / -distance(facet, m_interior);
+                };
+            T best = ratio(f);
+            for (;;) {
+                uint32_t next = f;
+                for (uint32_t g : m_facets[f].neighbors) {
+                    T r = ratio(g);
+                    if (r > best) {
+                        best = r;
+                        next = g;
+                    }
+                }
+                stats.orientationTest(D);
+                if (next == f) {
+                    return f;
+                }
+                f = next;
+            }
+        }
+
+        // Sorted vertices of 'facet' without slot 's', padded with none
+        static index_t ridgeKey(const index_t& vertices, int s) {
+            index_t key;
+            key.fill(none);
+            for (int j = 0, r = 0; j < D; j++) {
+                if (j != s) {
+                    key[r++] = vertices[j];
+                }
+            }
+            std::sort(key.begin(), key.begin() + (D - 1));
+            return key;
+        }
+
+        // Rebuilds every connected region of facets touching a bad vertex, false if one cannot be patched
+        bool repair(Statistics& stats) {
+            CORE_PROFILE_SCOPE("Hull::repair");
+            m_stamp += 2;
+            uint32_t regionStamp = m_stamp;
+            m_region.clear();
+            for (uint32_t f = 0; f < uint32_t(m_facets.size()); f++) {
+                for (uint32_t v : m_facets[f].vertices) {
+                    if (m_bad[v] == m_badStamp) {
+                        m_visit[f] = regionStamp;
+                        m_region.push_back(f);
+                        break;
+                    }
+                }
+            }
+            // Bad vertices can touch many more facets than broke, a region that big is not local
+            size_t limit = size_t(m_rebuildFraction * T(m_facets.size()));
+            if (m_region.size() > limit) {
+                return false;
+            }
+            for (uint32_t seed : m_region) {
+                if (m_visit[seed] != regionStamp) {
+                    continue;
+                }
+                m_stamp += 2;
+                uint32_t componentStamp = m_stamp;
+                m_component.clear();
+                m_component.push_back(seed);
+                m_visit[seed] = componentStamp;
+                for (size_t i = 0; i < m_component.size(); i++) {
+                    for (uint32_t g : m_facets[m_component[i]].neighbors) {
+                        if (m_visit[g] == regionStamp) {
+                            m_visit[g] = componentStamp;
+                            m_component.push_back(g);
+                        }
+                    }
+                }
+                // A kept facet that meets the cap concavely joins the region and the patch is retried
+                PatchResult result;
+                while ((result = patch(componentStamp, stats)) == PatchResult::Grow) {
+                    if (m_component.size() + m_grow.size() > limit) {
+                        return false;
+                    }
+                    for (uint32_t g : m_grow) {
+                        if (m_visit[g] != componentStamp) {
+                            m_visit[g] = componentStamp;
+                            m_component.push_back(g);
+                        }
+                    }
+                }
+                if (result == PatchResult::Failed) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        enum class PatchResult {
+            Patched, Grow, Failed
+        };
+
+        /*
+        * Replaces the facets of m_component by the outer part of the hull of their vertices
+        * without the bad ones, which the escape test puts back if they are still outside.
+        * That cap is glued where its facets meet the boundary ridges convexly and grown
+        * across the other ridges, so it must close exactly on the boundary.
+        */
+        PatchResult patch(uint32_t componentStamp, Statistics& stats) {
+            m_patchStamp++;
+            m_patchMark.resize(m_points.size(), 0);
+            m_patchPoints.clear();
+            m_patchIndex.clear();
+            m_boundary.clear();
+            for (uint32_t r : m_component) {
+                const Facet& facet = m_facets[r];
+                for (int s = 0; s < D; s++) {
+                    uint32_t v = facet.vertices[s];
+                    if (m_bad[v] != m_badStamp && m_patchMark[v] != m_patchStamp) {
+                        m_patchMark[v] = m_patchStamp;
+                        m_patchIndex.push_back(v);
+                        m_patchPoints.push_back(m_points[v]);
+                    }
+                    if (m_visit[facet.neighbors[s]] != componentStamp) {
+                        m_boundary.push_back({ ridgeKey(facet.vertices, s), facet.neighbors[s], r });
+                    }
+                }
+            }
+            // A region without boundary is the whole hull, nothing is left to glue the cap to
+            if (m_boundary.empty()) {
+                return PatchResult::Failed;
+            }
+            // Anything that does not add up is taken as a region too small to see the hull's shape
+            auto growAll = [&]() {
+                m_grow.clear();
+                for (const auto& b : m_boundary) {
+                    m_grow.push_back(b.kept);
+                }
+                return PatchResult::Grow;
+                };
+            if (!m_patch) {
+                m_patch = std::make_unique<Hull>();
+            }
+            if (!m_patch->build(std::span<const point_t>(m_patchPoints), stats)) {
+                return growAll();
+            }
+            const auto& cap = m_patch->facets();
+            auto global = [&](const index_t& local) {
+                index_t result;
+                for (int k = 0; k < D; k++) {
+                    result[k] = m_patchIndex[local[k]];
+                }
+                return result;
+                };
+            auto byKey = [](const auto& lhs, const auto& rhs) {
+                return lhs.key < rhs.key;
+                };
+            m_patchRidges.clear();
+            for (uint32_t q = 0; q < uint32_t(cap.size()); q++) {
+                index_t vertices = global(cap[q].vertices);
+                for (int s = 0; s < D; s++) {
+                    m_patchRidges.push_back({ ridgeKey(vertices, s), q, uint32_t(s) });
+                }
+            }
+            std::sort(m_patchRidges.begin(), m_patchRidges.end(), byKey);
+            std::sort(m_boundary.begin(), m_boundary.end(), byKey);
+
+            // 1 on the cap, 2 below it
+            m_capMark.assign(cap.size(), 0);
+            m_capStack.clear();
+            m_grow.clear();
+            for (const auto& b : m_boundary) {
+                auto [first, last] = std::equal_range(m_patchRidges.begin(), m_patchRidges.end(), Ridge{ b.key, 0, 0 }, byKey);
+                if (last - first != 2) {
+                    return growAll();
+                }
+                const Facet& kept = m_facets[b.kept];
+                uint32_t keptFar = none;
+                for (int t = 0; t < D; t++) {
+                    if (kept.neighbors[t] == b.facet) {
+                        keptFar = kept.vertices[t];
+                    }
+                }
+                // The outer of the two cap facets on the ridge leans the way of the kept facet,
+                // unless the other one is the kept facet itself, hulled again around a kept island
+                auto far = [&](auto ridge) {
+                    return m_patchIndex[cap[ridge->facet].vertices[ridge->slot]];
+                    };
+                auto lean = [&](auto ridge) {
+                    if (far(ridge) == keptFar) {
+                        return -std::numeric_limits<T>::max();
+                    }
+                    T result = 0;
+                    for (int k = 0; k < D; k++) {
+                        result += cap[ridge->facet].normal[k] * kept.normal[k];
+                    }
+                    return result;
+                    };
+                auto outerRidge = lean(first) >= lean(first + 1) ? first : first + 1;
+                uint32_t outer = outerRidge->facet;
+                uint32_t capFar = far(outerRidge);
+                Facet plane;
+                plane.normal = cap[outer].normal;
+                plane.offset = cap[outer].offset;
+                stats.orientationTest(2);
+                if (keptFar == none || distance(plane, m_points[keptFar]) > m_epsilon || distance(kept, m_points[capFar]) > m_epsilon) {
+                    m_grow.push_back(b.kept);
+                    continue;
+                }
+                uint32_t inner = first->facet == outer ? (first + 1)->facet : first->facet;
+                if (m_capMark[outer] == 2 || m_capMark[inner] == 1) {
+                    return growAll();
+                }
+                m_capMark[inner] = 2;
+                if (m_capMark[outer] == 0) {
+                    m_capMark[outer] = 1;
+                    m_capStack.push_back(outer);
+                }
+            }
+            if (!m_grow.empty()) {
+                return PatchResult::Grow;
+            }
+            auto isBoundary = [&](const index_t& key) {
+                return std::binary_search(m_boundary.begin(), m_boundary.end(), Boundary{ key, 0, 0 }, byKey);
+                };
+            while (!m_capStack.empty()) {
+                uint32_t q = m_capStack.back();
+                m_capStack.pop_back();
+                index_t vertices = global(cap[q].vertices);
+                for (int s = 0; s < D; s++) {
+                    if (isBoundary(ridgeKey(vertices, s))) {
+                        continue;
+                    }
+                    uint32_t next = cap[q].neighbors[s];
+                    if (m_capMark[next] == 2) {
+                        return growAll();
+                    }
+                    if (m_capMark[next] == 0) {
+                        m_capMark[next] = 1;
+                        m_capStack.push_back(next);
+                    }
+                }
+            }
+
+            // Swap the region for the cap
+            m_capIds.assign(cap.size(), none);
+            for (uint32_t q = 0; q < uint32_t(cap.size()); q++) {
+                if (m_capMark[q] == 1) {
+                    m_capIds[q] = addFacet(global(cap[q].vertices), stats);
+                }
+            }
+            size_t glued = 0;
+            for (uint32_t q = 0; q < uint32_t(cap.size()); q++) {
+                uint32_t id = m_capIds[q];
+                if (id == none) {
+                    continue;
+                }
+                for (int s = 0; s < D; s++) {
+                    index_t key = ridgeKey(m_facets[id].vertices, s);
+                    auto b = std::lower_bound(m_boundary.begin(), m_boundary.end(), Boundary{ key, 0, 0 }, byKey);
+                    if (b != m_boundary.end() && b->key == key) {
+                        m_facets[id].neighbors[s] = b->kept;
+                        for (auto& back : m_facets[b->kept].neighbors) {
+                            if (back == b->facet) {
+                                back = id;
+                                break;
+                            }
+                        }
+                        glued++;
+                        continue;
+                    }
+                    uint32_t v = m_facets[id].vertices[s];
+                    for (int t = 0; t < D; t++) {
+                        if (m_patchIndex[cap[q].vertices[t]] == v) {
+                            m_facets[id].neighbors[s] = m_capIds[cap[q].neighbors[t]];
+                        }
+                    }
+                }
+            }
+            // The kept facets already point at the cap, a cap that does not fit can only be rebuilt
+            if (glued != m_boundary.size() || !capFits(stats)) {
+                return PatchResult::Failed;
+            }
+            for (uint32_t r : m_component) {
+                m_alive[r] = 0;
+            }
+            stats.faceDestroyed(m_component.size());
+            m_report.repairedFacets += m_component.size();
+            return PatchResult::Patched;
+        }
+
+        // Every cap facet has its neighbors linked back, lies above the interior point and is convex at its ridges
+        bool capFits(Statistics& stats) const {
+            for (uint32_t id : m_capIds) {
+                if (id == none) {
+                    continue;
+                }
+                const Facet& facet = m_facets[id];
+                stats.orientationTest();
+                if (distance(facet, m_interior) > -m_epsilon) {
+                    return false;
+                }
+                for (int s = 0; s < D; s++) {
+                    uint32_t nb = facet.neighbors[s];
+                    // Two ridges on one neighbor means the cap doubled a kept facet
+                    if (nb == none || std::find(facet.neighbors.begin(), facet.neighbors.begin() + s, nb) != facet.neighbors.begin() + s
+                        || std::find(m_facets[nb].neighbors.begin(), m_facets[nb].neighbors.end(), id) == m_facets[nb].neighbors.end()) {
+                        return false;
+                    }
+                    // Both ways, a kept neighbor's plane was never tested against the cap
+                    stats.orientationTest(2);
+                    if (distance(facet, m_points[opposite(id, s)]) > m_epsilon || distance(m_facets[nb], m_points[facet.vertices[s]]) > m_epsilon) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Hands the candidates to the first new facet that sees them, the rest are inside
+        void assign(Statistics& stats) {
+            for (uint32_t q : m_candidates) {
+                const point_t& p = m_points[q];
+                for (uint32_t f : m_created) {
+                    T d = distance(m_facets[f], p);
+                    stats.orientationTest();
+                    if (d > m_epsilon) {
+                        stats.conflictUpdate();
+                        stats.growth(m_outside[f]);
+                        m_outside[f].push_back(q);
+                        if (d > m_furthestDistance[f]) {
+                            m_furthestDistance[f] = d;
+                            m_furthest[f] = q;
+                        }
+                        break;
+                    }
+                }
+            }
+            for (uint32_t f : m_created) {
+                if (!m_outside[f].empty()) {
+                    m_pending.push_back(f);
+                }
+            }
+        }
+
+        void insert(uint32_t start, Statistics& stats) {
+            uint32_t apex = m_furthest[start];
+            const point_t& p = m_points[apex];
+
+            // Facets that see the apex, visible ones get an even stamp and the others an odd one
+            m_stamp += 2;
+            uint32_t visibleStamp = m_stamp, hiddenStamp = m_stamp + 1;
+            m_visible.clear();
+            m_horizon.clear();
+            m_visible.push_back(start);
+            m_visit[start] = visibleStamp;
+            for (size_t i = 0; i < m_visible.size(); i++) {
+                uint32_t v = m_visible[i];
+                for (int s = 0; s < D; s++) {
+                    uint32_t nb = m_facets[v].neighbors[s];
+                    if (m_visit[nb] == visibleStamp) {
+                        continue;
+                    }
+                    if (m_visit[nb] != hiddenStamp) {
+                        stats.orientationTest();
+                        if (distance(m_facets[nb], p) > m_epsilon) {
+                            m_visit[nb] = visibleStamp;
+                            m_visible.push_back(nb);
+                            continue;
+                        }
+                        m_visit[nb] = hiddenStamp;
+                    }
+                    m_horizon.push_back({ v, uint32_t(s) });
+                }
+            }
+
+            // A cone from the apex over the horizon, each new facet replaces one visible facet's vertex
+            m_created.clear();
+            m_ridges.clear();
+            for (const auto& [v, s] : m_horizon) {
+                index_t vertices = m_facets[v].vertices;
+                vertices[s] = apex;
+                uint32_t nb = m_facets[v].neighbors[s];
+                uint32_t id = addFacet(vertices, stats);
+                m_created.push_back(id);
+                Facet& facet = m_facets[id];
+                int apexSlot = int(std::find(facet.vertices.begin(), facet.vertices.end(), apex) - facet.vertices.begin());
+                facet.neighbors[apexSlot] = nb;
+                for (auto& back : m_facets[nb].neighbors) {
+                    if (back == v) {
+                        back = id;
+                        break;
+                    }
+                }
+                // New facets meet along the apex and D - 2 horizon vertices
+                for (int k = 0; k < D; k++) {
+                    if (k == apexSlot) {
+                        continue;
+                    }
+                    Ridge ridge;
+                    ridge.key.fill(none);
+                    for (int j = 0, r = 0; j < D; j++) {
+                        if (j != k && j != apexSlot) {
+                            ridge.key[r++] = facet.vertices[j];
+                        }
+                    }
+                    std::sort(ridge.key.begin(), ridge.key.begin() + (D - 2));
+                    ridge.facet = id;
+                    ridge.slot = uint32_t(k);
+                    m_ridges.push_back(ridge);
+                }
+            }
+            std::sort(m_ridges.begin(), m_ridges.end(), [](const Ridge& lhs, const Ridge& rhs) {
+                return lhs.key < rhs.key;
+                });
+            for (size_t i = 0; i + 1 < m_ridges.size(); i += 2) {
+                const Ridge& a = m_ridges[i];
+                const Ridge& b = m_ridges[i + 1];
+                assert(a.key == b.key && "Horizon is not a closed ridge cycle");
+                m_facets[a.facet].neighbors[a.slot] = b.facet;
+                m_facets[b.facet].neighbors[b.slot] = a.facet;
+            }
+
+            // The visible facets die, their outside points look for a new facet
+            m_candidates.clear();
+            for (uint32_t v : m_visible) {
+                m_alive[v] = 0;
+                for (uint32_t q : m_outside[v]) {
+                    if (q != apex) {
+                        m_candidates.push_back(q);
+                    }
+                }
+                m_outside[v].clear();
+            }
+            stats.faceDestroyed(m_visible.size());
+            assign(stats);
+        }
+
+    private:
+        struct Horizon {
+            uint32_t facet;
+            uint32_t slot;
+        };
+
+        struct Ridge {
+            std::array<uint32_t, D> key;
+            uint32_t facet;
+            uint32_t slot;
+        };
+
+        // Ridge between a repaired facet and a kept one
+        struct Boundary {
+            index_t key;
+            uint32_t kept;
+            uint32_t facet;
+        };
+
+        std::span<const point_t> m_points;
+        std::vector<point_t> m_converted;
+        point_t m_interior = {};
+        T m_epsilon = 0;
+
+        std::vector<Facet> m_facets;
+        std::vector<std::vector<uint32_t>> m_outside;  // outlives its facet to keep the capacity
+        std::vector<uint32_t> m_furthest;
+        std::vector<T> m_furthestDistance;
+        std::vector<uint8_t> m_alive;
+        std::vector<uint32_t> m_visit;
+        uint32_t m_stamp = 0;
+
+        std::vector<uint32_t> m_pending;
+        std::vector<uint32_t> m_visible;
+        std::vector<Horizon> m_horizon;
+        std::vector<uint32_t> m_created;
+        std::vector<uint32_t> m_candidates;
+        std::vector<Ridge> m_ridges;
+
+        std::vector<uint32_t> m_remap;
+        std::vector<Facet> m_result;
+
+        // Kinetic update, per point facet of the last climb and marks
+        std::vector<uint32_t> m_witness;
+        std::vector<uint32_t> m_vertexMark;
+        std::vector<uint32_t> m_bad;
+        std::vector<uint32_t> m_hullVertices;
+        uint32_t m_vertexStamp = 0;
+        uint32_t m_badStamp = 0;
+        T m_rebuildFraction = T(0.25);
+        UpdateReport m_report;
+
+        // Local repair, the cap comes from a hull of the region's vertices
+        std::unique_ptr<Hull> m_patch;
+        std::vector<point_t> m_patchPoints;
+        std::vector<uint32_t> m_patchIndex;
+        std::vector<uint32_t> m_patchMark;
+        uint32_t m_patchStamp = 0;
+        std::vector<uint32_t> m_region;
+        std::vector<uint32_t> m_component;
+        std::vector<Boundary> m_boundary;
+        std::vector<Ridge> m_patchRidges;
+        std::vector<uint8_t> m_capMark;
+        std::vector<uint32_t> m_capStack;
+        std::vector<uint32_t> m_capIds;
+        std::vector<uint32_t> m_grow;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+// Hulls of many small independent point sets
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cstdint>
+
+#include "Point3D.h"
+#include "Pure3DHullAlgos.h"
+#include "Hull.h"
+#include "Core/ThreadPool.h"
+#include "Core/Profiler.h"
+
+namespace Core {
+
+    // Faces of set i are faces[faceOffsets[i], faceOffsets[i + 1]) and index the points of set i
+    template<typename T>
+    struct HullBatchResult {
+        std::vector<uint32_t> faceOffsets;
+        std::vector<Tface<T>> faces;
+    };
+
+    /*
+    * Hulls every set of a CSR collection: set i is points[offsets[i], offsets[i + 1]).
+    * Each worker of the pool keeps one Hull<3, T> and one face buffer for the whole run,
+    * both keep their capacity between runs, so a warm engine does not allocate per hull.
+    * Sets that do not span 3D get no faces.
+    *
+    * How to use:
+    * ThreadPool pool;
+    * HullBatchEngine<float> engine(pool);
+    * HullBatchResult<float> hulls;
+    * engine.run(offsets, points, hulls);      // reuse 'hulls' next frame
+    */
+    template<typename T>
+    class HullBatchEngine {
+    public:
+        using point_t = point3D<T>;
+        using face_t = Tface<T>;
+
+        explicit HullBatchEngine(ThreadPool& pool, size_t grain = 64)
+            : m_pool(pool), m_grain(grain), m_scratch(pool.getWorkerCount()) {
+        }
+
+        void run(std::span<const uint32_t> offsets, std::span<const point_t> points, HullBatchResult<T>& result) {
+            CORE_PROFILE_FUNCTION();
+            size_t sets = offsets.empty() ? 0 : offsets.size() - 1;
+            result.faceOffsets.assign(sets + 1, 0);
+            for (auto& scratch : m_scratch) {
+                scratch.faces.clear();
+                scratch.runs.clear();
+            }
+
+            // Every worker appends its hulls to its own buffer and records the count per set
+            m_pool.parallelFor(sets, m_grain, [&](size_t begin, size_t end, int worker) {
+                Scratch& scratch = m_scratch[worker];
+                for (size_t set = begin; set < end; set++) {
+                    uint32_t first = offsets[set];
+                    uint32_t count = offsets[set + 1] - first;
+                    scratch.points.resize(count);
+                    for (uint32_t i = 0; i < count; i++) {
+                        const point_t& p = points[first + i];
+                        scratch.points[i] = { p.x, p.y, p.z };
+                    }
+                    uint32_t start = uint32_t(scratch.faces.size());
+                    if (scratch.hull.build(std::span<const typename hull_t::point_t>(scratch.points))) {
+                        for (const auto& facet : scratch.hull.facets()) {
+                            point_t n(facet.normal[0], facet.normal[1], facet.normal[2]);
+                            scratch.faces.emplace_back(facet.vertices[0], facet.vertices[1], facet.vertices[2], n, facet.offset);
+                        }
+                    }
+                    uint32_t faceCount = uint32_t(scratch.faces.size()) - start;
+                    scratch.runs.push_back({ uint32_t(set), start, faceCount });
+                    result.faceOffsets[set + 1] = faceCount;
+                }
+                });
+
+            for (size_t set = 0; set < sets; set++) {
+                result.faceOffsets[set + 1] += result.faceOffsets[set];
+            }
+            result.faces.resize(result.faceOffsets[sets], face_t(0, 0, 0, point_t(), T(0)));
+
+            // Scatter the worker buffers into the packed output
+            m_pool.parallelFor(m_scratch.size(), 1, [&](size_t begin, size_t end, int) {
+                for (size_t w = begin; w < end; w++) {
+                    const Scratch& scratch = m_scratch[w];
+                    for (const auto& run : scratch.runs) {
+                        std::copy_n(scratch.faces.begin() + run.start, run.count, result.faces.begin() + result.faceOffsets[run.set]);
+                    }
+                }
+                });
+        }
+
+    private:
+        using hull_t = Hull<3, T>;
+
+        struct Run {
+            uint32_t set;
+            uint32_t start;
+            uint32_t count;
+        };
+
+        // A cache line apart, workers grow their own vectors
+        struct alignas(64) Scratch {
+            hull_t hull;
+            std::vector<typename hull_t::point_t> points;
+            std::vector<face_t> faces;
+            std::vector<Run> runs;
+        };
+
+        ThreadPool& m_pool;
+        size_t m_grain;
+        std::vector<Scratch> m_scratch;
+    };
+}
\ No newline at end of file
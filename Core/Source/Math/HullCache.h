@@ -0,0 +1,262 @@
+// Content addressed cache of ConvexHullMachine results
+#pragma once
+
+#include <vector>
+#include <list>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <unordered_map>
+#include <filesystem>
+
+#include "Point3D.h"
+#include "Pure3DHullAlgos.h"
+#include "HullIO.h"
+
+namespace Core {
+
+    enum class HullAlgorithm : uint32_t {
+        GiftWrapping, Incremental, IncrementalFast
+    };
+
+    // 128-bit content hash, collisions are treated as impossible
+    struct HullKey {
+        uint64_t lo, hi;
+
+        bool operator==(const HullKey& other) const {
+            return lo == other.lo && hi == other.hi;
+        }
+    };
+
+    struct HullKeyHash {
+        size_t operator()(const HullKey& key) const {
+            return size_t(key.lo ^ (key.hi * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    namespace HullHash {
+        constexpr uint64_t prime1 = 0x9E3779B185EBCA87ull;
+        constexpr uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr uint64_t prime3 = 0x165667B19E3779F9ull;
+
+        inline uint64_t rotl(uint64_t x, int r) {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        inline uint64_t avalanche(uint64_t h) {
+            h ^= h >> 33;
+            h *= prime2;
+            h ^= h >> 29;
+            h *= prime3;
+            h ^= h >> 32;
+            return h;
+        }
+
+        // Four independent 64-bit lanes over 32-byte blocks, the compiler keeps them in vector registers
+        inline HullKey bytes(const void* data, size_t size, uint64_t seed) {
+            uint64_t lanes[4] = { seed + prime1 + prime2, seed + prime2, seed, seed - prime1 };
+            const uint8_t* p = static_cast<const uint8_t*>(data);
+            size_t blocks = size / 32;
+            for (size_t b = 0; b < blocks; b++) {
+                uint64_t words[4];
+                std::memcpy(words, p + b * 32, 32);
+                for (int l = 0; l < 4; l++) {
+                    lanes[l] = rotl(lanes[l] + words[l] * prime2, 31) * prime1;
+                }
+            }
+            uint64_t tail[4] = {};
+            std::memcpy(tail, p + blocks * 32, size - blocks * 32);
+            for (int l = 0; l < 4; l++) {
+                lanes[l] = rotl(lanes[l] + tail[l] * prime2, 31) * prime1;
+            }
+            uint64_t lo = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+            uint64_t hi = rotl(lanes[0], 23) ^ rotl(lanes[1], 37) ^ (lanes[2] * prime3) ^ rotl(lanes[3], 47);
+            return { avalanche(lo ^ size), avalanche(hi + size * prime1) };
+        }
+    }
+
+    /*
+    * LRU cache in front of ConvexHullMachine with an optional on-disk tier.
+    * The key hashes the points, the algorithm, epsilon and the scalar type.
+    *
+    * ConvexHullMachine reorders its input and the faces index the reordered points,
+    * so an entry keeps both and a hit writes the reordered points back into 'p'.
+    *
+    * How to use:
+    * HullCache<double> cache(64 << 20, "Cache/Hull");
+    * auto hull = cache.incrementalFast(p);
+    */
+    template<typename T, T initialEpsilon = static_cast<T>(1e-9)>
+    class HullCache {
+    public:
+        using point_t = point3D<T>;
+        using face_t = Tface<T>;
+        using machine_t = ConvexHullMachine<T, initialEpsilon>;
+
+        // 'capacity' in bytes of cached points and faces, empty 'directory' keeps the cache in memory
+        explicit HullCache(size_t capacity = size_t(64) << 20, const std::string& directory = "")
+            : m_capacity(capacity), m_directory(directory) {
+        }
+
+        std::vector<face_t> giftWrapping(std::vector<point_t>& p) {
+            return get(HullAlgorithm::GiftWrapping, p);
+        }
+
+        std::vector<face_t> incremental(std::vector<point_t>& p) {
+            return get(HullAlgorithm::Incremental, p);
+        }
+
+        std::vector<face_t> incrementalFast(std::vector<point_t>& p) {
+            return get(HullAlgorithm::IncrementalFast, p);
+        }
+
+        std::vector<face_t> get(HullAlgorithm algorithm, std::vector<point_t>& p) {
+            CORE_PROFILE_FUNCTION();
+            HullKey key = computeKey(algorithm, p);
+            auto it = m_index.find(key);
+            if (it != m_index.end()) {
+                m_hits++;
+                m_entries.splice(m_entries.begin(), m_entries, it->second);
+                p = it->second->points;
+                return it->second->faces;
+            }
+            Entry entry;
+            if (load(key, entry)) {
+                m_diskHits++;
+            }
+            else {
+                m_misses++;
+                entry.faces = compute(algorithm, p);
+                entry.points = p;
+                store(key, entry);
+            }
+            p = entry.points;
+            std::vector<face_t> faces = entry.faces;
+            insert(key, std::move(entry));
+            return faces;
+        }
+
+        static HullKey computeKey(HullAlgorithm algorithm, const std::vector<point_t>& p) {
+            T epsilon = initialEpsilon;
+            uint64_t epsilonBits = 0;
+            std::memcpy(&epsilonBits, &epsilon, sizeof(T));
+            uint64_t seed = HullHash::avalanche(uint64_t(algorithm) << 32 ^ sizeof(T) ^ epsilonBits * HullHash::prime1);
+            return HullHash::bytes(p.data(), p.size() * sizeof(point_t), seed);
+        }
+
+        void clear() {
+            m_entries.clear();
+            m_index.clear();
+            m_size = 0;
+        }
+
+        uint64_t hits() const {
+            return m_hits;
+        }
+
+        uint64_t diskHits() const {
+            return m_diskHits;
+        }
+
+        uint64_t misses() const {
+            return m_misses;
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+    private:
+        struct Entry {
+            HullKey key = {};
+            std::vector<point_t> points;
+            std::vector<face_t> faces;
+
+            size_t bytes() const {
+                return points.size() * sizeof(point_t) + faces.size() * sizeof(face_t);
+            }
+        };
+
+        static std::vector<face_t> compute(HullAlgorithm algorithm, std::vector<point_t>& p) {
+            switch (algorithm) {
+            case HullAlgorithm::GiftWrapping: return machine_t::giftWrapping(p);
+            case HullAlgorithm::Incremental: return machine_t::incremental(p);
+            default: return machine_t::incrementalFast(p);
+            }
+        }
+
+        void insert(const HullKey& key, Entry&& entry) {
+            entry.key = key;
+            size_t bytes = entry.bytes();
+            if (bytes > m_capacity) {
+                return;
+            }
+            while (m_size + bytes > m_capacity) {
+                m_size -= m_entries.back().bytes();
+                m_index.erase(m_entries.back().key);
+                m_entries.pop_back();
+            }
+            m_entries.push_front(std::move(entry));
+            m_index[key] = m_entries.begin();
+            m_size += bytes;
+        }
+
+        std::string path(const HullKey& key) const {
+            char name[40];
+            std::snprintf(name, sizeof(name), "%016llx%016llx.hull", (unsigned long long)key.hi, (unsigned long long)key.lo);
+            return m_directory + "/" + name;
+        }
+
+        bool load(const HullKey& key, Entry& entry) const {
+            if (m_directory.empty()) {
+                return false;
+            }
+            HullFile<T> file;
+            if (!file.open(path(key))) {
+                return false;
+            }
+            const HullView<T>& view = file.view();
+            entry.points.reserve(view.vertices.size());
+            for (const auto& v : view.vertices) {
+                entry.points.emplace_back(v.x, v.y, v.z);
+            }
+            entry.faces.reserve(view.faces.size());
+            for (size_t i = 0; i < view.faces.size(); i++) {
+                const auto& f = view.faces[i];
+                const auto& plane = view.planes[i];
+                entry.faces.emplace_back(f.a, f.b, f.c, point_t(plane.nx, plane.ny, plane.nz), plane.d);
+            }
+            return true;
+        }
+
+        void store(const HullKey& key, const Entry& entry) const {
+            if (m_directory.empty()) {
+                return;
+            }
+            std::error_code error;
+            std::filesystem::create_directories(m_directory, error);
+            // Written aside and renamed, readers never see a partial file
+            std::string target = path(key);
+            std::string temporary = target + ".tmp";
+            HullWriteOptions options;
+            options.compactVertices = false;
+            if (writeHull(temporary, entry.points, entry.faces, options)) {
+                std::filesystem::rename(temporary, target, error);
+            }
+            else {
+                std::filesystem::remove(temporary, error);
+            }
+        }
+
+    private:
+        size_t m_capacity;
+        size_t m_size = 0;
+        std::string m_directory;
+        std::list<Entry> m_entries;     // most recently used first
+        std::unordered_map<HullKey, typename std::list<Entry>::iterator, HullKeyHash> m_index;
+        uint64_t m_hits = 0;
+        uint64_t m_diskHits = 0;
+        uint64_t m_misses = 0;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,329 @@
+// Hull serialization: binary hull files and PLY/OBJ/STL exporters
+#pragma once
+
+#include <vector>
+#include <string>
+#include <span>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <unordered_map>
+
+#include "Point3D.h"
+#include "Pure3DHullAlgos.h"
+#include "Core/FileSink.h"
+#include "Core/MappedFile.h"
+
+namespace Core {
+
+    /*
+    * Binary hull file, little endian, every table 64-byte aligned:
+    *
+    * HullFileHeader
+    * vertices   HullVertex<T>[vertexCount]
+    * faces      HullIndices[faceCount]         counter-clockwise seen from outside
+    * planes     HullPlane<T>[faceCount]        dot(n, p) + d > 0 outside
+    * adjacency  HullIndices[faceCount]         optional, face across edge ab, bc, ca
+    *
+    * Tables are read in place from a memory map, opening does not touch them.
+    */
+    struct HullFileHeader {
+        static constexpr char magicValue[4] = { 'C', 'H', 'U', 'L' };
+        static constexpr uint32_t currentVersion = 1;
+        static constexpr uint32_t hasAdjacency = 1;
+        static constexpr uint64_t alignment = 64;
+
+        char magic[4];
+        uint32_t version;
+        uint32_t scalarSize;        // sizeof(T), 4 or 8
+        uint32_t flags;
+        uint64_t vertexCount;
+        uint64_t faceCount;
+        uint64_t vertexOffset;
+        uint64_t faceOffset;
+        uint64_t planeOffset;
+        uint64_t adjacencyOffset;   // 0 without adjacency
+    };
+    static_assert(sizeof(HullFileHeader) == 64, "HullFileHeader is part of the file format");
+
+    // File layouts, independent of point3D and Tface
+    template<typename T>
+    struct HullVertex {
+        T x, y, z;
+    };
+
+    struct HullIndices {
+        static constexpr uint32_t none = 0xFFFFFFFFu;
+        uint32_t a, b, c;
+    };
+
+    template<typename T>
+    struct HullPlane {
+        T nx, ny, nz, d;
+    };
+
+    template<typename T>
+    struct HullView {
+        std::span<const HullVertex<T>> vertices;
+        std::span<const HullIndices> faces;
+        std::span<const HullPlane<T>> planes;
+        std::span<const HullIndices> adjacency;    // empty when the file has none
+    };
+
+    struct HullWriteOptions {
+        bool adjacency = false;
+        // Keep only hull vertices, otherwise faces keep indexing the whole input
+        bool compactVertices = true;
+    };
+
+    // Numbers the vertices used by the faces in order of first use
+    template<typename T>
+    struct HullVertexMap {
+        std::vector<uint32_t> remap;    // input index -> output index, HullIndices::none when unused
+        std::vector<uint32_t> order;    // output index -> input index
+
+        HullVertexMap(const std::vector<point3D<T>>& points, const std::vector<Tface<T>>& faces, bool compact) {
+            if (!compact) {
+                remap.resize(points.size());
+                order.resize(points.size());
+                for (uint32_t i = 0; i < uint32_t(points.size()); i++) {
+                    remap[i] = order[i] = i;
+                }
+                return;
+            }
+            remap.assign(points.size(), HullIndices::none);
+            for (const auto& f : faces) {
+                for (uint32_t v : { f.a, f.b, f.c }) {
+                    if (remap[v] == HullIndices::none) {
+                        remap[v] = uint32_t(order.size());
+                        order.push_back(v);
+                    }
+                }
+            }
+        }
+    };
+
+    // Face across each edge of every face, HullIndices::none on open edges
+    template<typename T>
+    std::vector<HullIndices> hullAdjacency(const std::vector<Tface<T>>& faces) {
+        auto h = [](uint32_t a, uint32_t b) {
+            return uint64_t(a) << 32 | b;
+            };
+        std::unordered_map<uint64_t, uint32_t> edges;
+        edges.reserve(faces.size() * 3);
+        for (uint32_t i = 0; i < uint32_t(faces.size()); i++) {
+            const auto& f = faces[i];
+            edges[h(f.a, f.b)] = edges[h(f.b, f.c)] = edges[h(f.c, f.a)] = i;
+        }
+        auto across = [&](uint32_t a, uint32_t b) {
+            auto it = edges.find(h(b, a));
+            return it == edges.end() ? HullIndices::none : it->second;
+            };
+        std::vector<HullIndices> adjacency(faces.size());
+        for (size_t i = 0; i < faces.size(); i++) {
+            const auto& f = faces[i];
+            adjacency[i] = { across(f.a, f.b), across(f.b, f.c), across(f.c, f.a) };
+        }
+        return adjacency;
+    }
+
+    template<typename T>
+    void writeHull(FileSink& sink, const std::vector<point3D<T>>& points, const std::vector<Tface<T>>& faces,
+                   const HullWriteOptions& options = {}) {
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Hull files store float or double");
+        constexpr uint64_t A = HullFileHeader::alignment;
+        auto aligned = [](uint64_t offset) {
+            return (offset + A - 1) / A * A;
+            };
+        HullVertexMap<T> map(points, faces, options.compactVertices);
+
+        HullFileHeader header = {};
+        std::memcpy(header.magic, HullFileHeader::magicValue, 4);
+        header.version = HullFileHeader::currentVersion;
+        header.scalarSize = sizeof(T);
+        header.flags = options.adjacency ? HullFileHeader::hasAdjacency : 0;
+        header.vertexCount = map.order.size();
+        header.faceCount = faces.size();
+        header.vertexOffset = aligned(sizeof(HullFileHeader));
+        header.faceOffset = aligned(header.vertexOffset + header.vertexCount * sizeof(HullVertex<T>));
+        header.planeOffset = aligned(header.faceOffset + header.faceCount * sizeof(HullIndices));
+        header.adjacencyOffset = options.adjacency
+            ? aligned(header.planeOffset + header.faceCount * sizeof(HullPlane<T>)) : 0;
+        sink.writeValue(header);
+
+        sink.pad(A);
+        for (uint32_t i : map.order) {
+            sink.writeValue(HullVertex<T>{ points[i].x, points[i].y, points[i].z });
+        }
+        sink.pad(A);
+        for (const auto& f : faces) {
+            sink.writeValue(HullIndices{ map.remap[f.a], map.remap[f.b], map.remap[f.c] });
+        }
+        sink.pad(A);
+        for (const auto& f : faces) {
+            sink.writeValue(HullPlane<T>{ f.n.x, f.n.y, f.n.z, f.d });
+        }
+        if (options.adjacency) {
+            sink.pad(A);
+            auto adjacency = hullAdjacency(faces);
+            sink.write(adjacency.data(), adjacency.size() * sizeof(HullIndices));
+        }
+    }
+
+    template<typename T>
+    bool writeHull(const std::string& path, const std::vector<point3D<T>>& points, const std::vector<Tface<T>>& faces,
+                   const HullWriteOptions& options = {}) {
+        FileSink sink(path);
+        writeHull(sink, points, faces, options);
+        return sink.flush();
+    }
+
+    /*
+    * Memory mapped hull file, the view points straight into the mapping
+    * and stays valid while this object lives.
+    *
+    * How to use:
+    * HullFile<double> file;
+    * if (file.open("hull.bin")) for (const auto& f : file.view().faces) ...
+    */
+    template<typename T>
+    class HullFile {
+    public:
+        bool open(const std::string& path) {
+            m_view = {};
+            if (!m_file.open(path)) {
+                return false;
+            }
+            if (!validate()) {
+                m_file.close();
+                return false;
+            }
+            const uint8_t* data = m_file.getData();
+            const auto& header = *reinterpret_cast<const HullFileHeader*>(data);
+            m_view.vertices = { reinterpret_cast<const HullVertex<T>*>(data + header.vertexOffset), size_t(header.vertexCount) };
+            m_view.faces = { reinterpret_cast<const HullIndices*>(data + header.faceOffset), size_t(header.faceCount) };
+            m_view.planes = { reinterpret_cast<const HullPlane<T>*>(data + header.planeOffset), size_t(header.faceCount) };
+            if (header.flags & HullFileHeader::hasAdjacency) {
+                m_view.adjacency = { reinterpret_cast<const HullIndices*>(data + header.adjacencyOffset), size_t(header.faceCount) };
+            }
+            return true;
+        }
+
+        bool isOpen() const {
+            return m_file.isOpen();
+        }
+
+        const HullView<T>& view() const {
+            return m_view;
+        }
+
+    private:
+        // Header sanity and table bounds only, the tables are not scanned
+        bool validate() const {
+            size_t size = m_file.getSize();
+            if (size < sizeof(HullFileHeader)) {
+                return false;
+            }
+            const auto& header = *reinterpret_cast<const HullFileHeader*>(m_file.getData());
+            if (std::memcmp(header.magic, HullFileHeader::magicValue, 4) != 0
+                || header.version != HullFileHeader::currentVersion
+                || header.scalarSize != sizeof(T)) {
+                return false;
+            }
+            auto fits = [&](uint64_t offset, uint64_t count, uint64_t elementSize) {
+                return offset % HullFileHeader::alignment == 0
+                    && offset <= size
+                    && count <= (size - offset) / elementSize;
+                };
+            bool adjacency = header.flags & HullFileHeader::hasAdjacency;
+            return fits(header.vertexOffset, header.vertexCount, sizeof(HullVertex<T>))
+                && fits(header.faceOffset, header.faceCount, sizeof(HullIndices))
+                && fits(header.planeOffset, header.faceCount, sizeof(HullPlane<T>))
+                && (!adjacency || fits(header.adjacencyOffset, header.faceCount, sizeof(HullIndices)));
+        }
+
+    private:
+        MappedFile m_file;
+        HullView<T> m_view;
+    };
+
+    // Binary little endian PLY, hull vertices only
+    template<typename T>
+    void exportPly(FileSink& sink, const std::vector<point3D<T>>& points, const std::vector<Tface<T>>& faces) {
+        HullVertexMap<T> map(points, faces, true);
+        char header[256];
+        int length = std::snprintf(header, sizeof(header),
+            "ply\nformat binary_little_endian 1.0\n"
+            "element vertex %zu\nproperty %s x\nproperty %s y\nproperty %s z\n"
+            "element face %zu\nproperty list uchar uint vertex_indices\nend_header\n",
+            map.order.size(), sizeof(T) == 4 ? "float" : "double", sizeof(T) == 4 ? "float" : "double",
+            sizeof(T) == 4 ? "float" : "double", faces.size());
+        sink.write(header, size_t(length));
+        for (uint32_t i : map.order) {
+            sink.writeValue(HullVertex<T>{ points[i].x, points[i].y, points[i].z });
+        }
+        for (const auto& f : faces) {
+            sink.writeValue(uint8_t(3));
+            sink.writeValue(HullIndices{ map.remap[f.a], map.remap[f.b], map.remap[f.c] });
+        }
+    }
+
+    // Wavefront OBJ, hull vertices only, 1-based indices
+    template<typename T>
+    void exportObj(FileSink& sink, const std::vector<point3D<T>>& points, const std::vector<Tface<T>>& faces) {
+        HullVertexMap<T> map(points, faces, true);
+        char line[128];
+        for (uint32_t i : map.order) {
+            int length = std::snprintf(line, sizeof(line), "v %.9g %.9g %.9g\n",
+                double(points[i].x), double(points[i].y), double(points[i].z));
+            sink.write(line, size_t(length));
+        }
+        for (const auto& f : faces) {
+            int length = std::snprintf(line, sizeof(line), "f %u %u %u\n",
+                map.remap[f.a] + 1, map.remap[f.b] + 1, map.remap[f.c] + 1);
+            sink.write(line, size_t(length));
+        }
+    }
+
+    // Binary STL, unit normals, single precision as the format requires
+    template<typename T>
+    void exportStl(FileSink& sink, const std::vector<point3D<T>>& points, const std::vector<Tface<T>>& faces) {
+        char header[80] = "ConvexHull binary STL";
+        sink.write(header, sizeof(header));
+        sink.writeValue(uint32_t(faces.size()));
+        for (const auto& f : faces) {
+            double length = std::sqrt(double(dot(f.n, f.n)));
+            double scale = length > 0 ? 1.0 / length : 0.0;
+            float record[12] = {
+                float(f.n.x * scale), float(f.n.y * scale), float(f.n.z * scale),
+                float(points[f.a].x), float(points[f.a].y), float(points[f.a].z),
+                float(points[f.b].x), float(points[f.b].y), float(points[f.b].z),
+                float(points[f.c].x), float(points[f.c].y), float(points[f.c].z),
+            };
+            sink.write(record, sizeof(record));
+            sink.writeValue(uint16_t(0));
+        }
+    }
+
+    template<typename T>
+    bool exportPly(const std::string& path, const std::vector<point3D<T>>& points, const std::vector<Tface<T>>& faces) {
+        FileSink sink(path);
+        exportPly(sink, points, faces);
+        return sink.flush();
+    }
+
+    template<typename T>
+    bool exportObj(const std::string& path, const std::vector<point3D<T>>& points, const std::vector<Tface<T>>& faces) {
+        FileSink sink(path);
+        exportObj(sink, points, faces);
+        return sink.flush();
+    }
+
+    template<typename T>
+    bool exportStl(const std::string& path, const std::vector<point3D<T>>& points, const std::vector<Tface<T>>& faces) {
+        FileSink sink(path);
+        exportStl(sink, points, faces);
+        return sink.flush();
+    }
+}
\ No newline at end of file
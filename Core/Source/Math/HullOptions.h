@@ -0,0 +1,35 @@
+// Run options of the hull engines
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+    class ThreadPool;
+
+    enum class InsertionOrder {
+        Shuffle,        // uniformly random
+        Brio,           // random rounds, each along a Morton curve, see brioOrder()
+    };
+
+    enum class Precision {
+        Native,         // every orientation test in the engine's type
+        Filtered,       // float tests with an error bound, the doubtful ones again in double
+    };
+
+    /*
+    * How to use:
+    * HullOptions options;
+    * options.order = InsertionOrder::Brio;
+    * options.pool = &pool;
+    * auto hull = ConvexHullMachine<double>::incrementalFast(p, options);
+    */
+    struct HullOptions {
+        InsertionOrder order = InsertionOrder::Shuffle;
+        uint64_t seed = 0;              // 0 seeds from the clock
+        ThreadPool* pool = nullptr;     // parallel ordering when set
+        Precision precision = Precision::Native;    // Filtered is only used by ConvexHullMachine<float>
+        size_t memoryBudget = 0;        // soft limit on the working set of incrementalFast in bytes, 0 for none
+    };
+}
\ No newline at end of file
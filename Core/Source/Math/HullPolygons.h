@@ -0,0 +1,216 @@
+// Coplanar hull faces merged into convex polygons
+#pragma once
+
+#include <vector>
+#include <numeric>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <tuple>
+
+#include "Point3D.h"
+#include "Pure3DHullAlgos.h"
+#include "Core/Profiler.h"
+
+namespace Core {
+
+    // Polygon i is vertices[offsets[i], offsets[i + 1]), counter-clockwise seen from outside,
+    // on the plane dot(normals[i], x) + distances[i] = 0 with a unit normal
+    template<typename T>
+    struct HullPolygons {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> vertices;
+        std::vector<point3D<T>> normals;
+        std::vector<T> distances;
+    };
+
+    /*
+    * Merges adjacent faces that lie on one plane into a single polygon and drops the vertices
+    * that end up inside a polygon or in the middle of a straight boundary run.
+    * 'faces' is the output of a 3D engine and indexes 'p', both ConvexHullMachine and Hull<3, T>::faces() fit.
+    *
+    * Two faces are on one plane when each one's far vertex is within tolerance * (bounding box diagonal)
+    * of the other one's plane and of the plane of the polygon it would join, so a finely curved
+    * surface does not drift into one polygon. A polygon whose boundary does not close into one loop
+    * is reported as its triangles.
+    *
+    * How to use:
+    * auto faces = ConvexHullMachine<double>::incrementalFast(p);
+    * auto polygons = mergeCoplanar(p, faces);
+    */
+    template<typename T>
+    HullPolygons<T> mergeCoplanar(const std::vector<point3D<T>>& p, const std::vector<Tface<T>>& faces, T tolerance = T(1e-6)) {
+        CORE_PROFILE_FUNCTION();
+        using point_t = point3D<T>;
+        HullPolygons<T> result;
+        result.offsets.push_back(0);
+        uint32_t count = uint32_t(faces.size());
+        if (count == 0) {
+            return result;
+        }
+
+        point_t lo = p[faces[0].a], hi = lo;
+        for (const auto& f : faces) {
+            for (uint32_t v : { f.a, f.b, f.c }) {
+                lo = point_t(std::min(lo.x, p[v].x), std::min(lo.y, p[v].y), std::min(lo.z, p[v].z));
+                hi = point_t(std::max(hi.x, p[v].x), std::max(hi.y, p[v].y), std::max(hi.z, p[v].z));
+            }
+        }
+        T epsilon = tolerance * abs(hi - lo);
+
+        std::vector<point_t> normals(count);
+        std::vector<T> distances(count);
+        for (uint32_t i = 0; i < count; i++) {
+            T length = abs(faces[i].n);
+            normals[i] = length > 0 ? faces[i].n / length : faces[i].n;
+            distances[i] = length > 0 ? faces[i].d / length : faces[i].d;
+        }
+        auto distance = [&](uint32_t f, uint32_t v) {
+            return dot(normals[f], p[v]) + distances[f];
+            };
+
+        // Directed edges sorted by (from, to), the twin of a -> b is found as b -> a
+        struct Edge {
+            uint64_t key;
+            uint32_t face;
+            uint32_t far;
+        };
+        auto edgeKey = [](uint32_t a, uint32_t b) {
+            return uint64_t(a) << 32 | b;
+            };
+        std::vector<Edge> edges;
+        edges.reserve(size_t(count) * 3);
+        for (uint32_t i = 0; i < count; i++) {
+            const auto& f = faces[i];
+            edges.push_back({ edgeKey(f.a, f.b), i, f.c });
+            edges.push_back({ edgeKey(f.b, f.c), i, f.a });
+            edges.push_back({ edgeKey(f.c, f.a), i, f.b });
+        }
+        std::sort(edges.begin(), edges.end(), [](const Edge& lhs, const Edge& rhs) {
+            return lhs.key < rhs.key;
+            });
+        auto twin = [&](const Edge& e) -> const Edge* {
+            uint64_t key = e.key << 32 | e.key >> 32;
+            auto it = std::lower_bound(edges.begin(), edges.end(), key, [](const Edge& lhs, uint64_t k) {
+                return lhs.key < k;
+                });
+            return it != edges.end() && it->key == key ? &*it : nullptr;
+            };
+
+        // Union-find over the faces, a set is represented by the plane of its root
+        std::vector<uint32_t> parent(count);
+        std::iota(parent.begin(), parent.end(), 0);
+        auto find = [&](uint32_t f) {
+            while (parent[f] != f) {
+                parent[f] = parent[parent[f]];
+                f = parent[f];
+            }
+            return f;
+            };
+        for (const auto& e : edges) {
+            const Edge* t = twin(e);
+            if (!t || e.face > t->face) {
+                continue;
+            }
+            uint32_t rootE = find(e.face), rootT = find(t->face);
+            if (rootE == rootT) {
+                continue;
+            }
+            if (std::abs(distance(e.face, t->far)) <= epsilon && std::abs(distance(t->face, e.far)) <= epsilon
+                && std::abs(distance(rootE, t->far)) <= epsilon && std::abs(distance(rootT, e.far)) <= epsilon) {
+                parent[std::max(rootE, rootT)] = std::min(rootE, rootT);
+            }
+        }
+
+        // Boundary edges of every set, grouped by root
+        struct Boundary {
+            uint32_t root;
+            uint32_t from, to;
+        };
+        std::vector<Boundary> boundary;
+        for (const auto& e : edges) {
+            const Edge* t = twin(e);
+            uint32_t root = find(e.face);
+            if (!t || find(t->face) != root) {
+                boundary.push_back({ root, uint32_t(e.key >> 32), uint32_t(e.key) });
+            }
+        }
+        std::sort(boundary.begin(), boundary.end(), [](const Boundary& lhs, const Boundary& rhs) {
+            return std::tie(lhs.root, lhs.from) < std::tie(rhs.root, rhs.from);
+            });
+
+        auto emit = [&](uint32_t plane) {
+            result.offsets.push_back(uint32_t(result.vertices.size()));
+            result.normals.push_back(normals[plane]);
+            result.distances.push_back(distances[plane]);
+            };
+        std::vector<uint32_t> loop;
+        for (size_t begin = 0, end; begin < boundary.size(); begin = end) {
+            uint32_t root = boundary[begin].root;
+            for (end = begin; end < boundary.size() && boundary[end].root == root; end++) {
+            }
+
+            // Walk from -> to, one loop must take every boundary edge of the set once
+            auto outgoing = [&](uint32_t from) {
+                auto it = std::lower_bound(boundary.begin() + begin, boundary.begin() + end, from, [](const Boundary& lhs, uint32_t v) {
+                    return lhs.from < v;
+                    });
+                return it != boundary.begin() + end && it->from == from ? it : boundary.end();
+                };
+            loop.clear();
+            bool closed = true;
+            for (size_t i = begin + 1; i < end; i++) {
+                closed = closed && boundary[i].from != boundary[i - 1].from;
+            }
+            uint32_t v = boundary[begin].from;
+            while (closed) {
+                loop.push_back(v);
+                auto it = outgoing(v);
+                closed = it != boundary.end();
+                if (!closed || it->to == loop.front() || loop.size() == end - begin) {
+                    closed = closed && it->to == loop.front() && loop.size() == end - begin;
+                    break;
+                }
+                v = it->to;
+            }
+            if (!closed) {
+                for (uint32_t i = 0; i < count; i++) {
+                    if (find(i) == root) {
+                        result.vertices.insert(result.vertices.end(), { faces[i].a, faces[i].b, faces[i].c });
+                        emit(i);
+                    }
+                }
+                continue;
+            }
+
+            // Drops a vertex that lies on the segment between its kept neighbors
+            auto straight = [&](uint32_t a, uint32_t b, uint32_t c) {
+                point_t ac = p[c] - p[a];
+                T length = abs(ac);
+                return length > 0 && abs(cross(ac, p[b] - p[a])) <= epsilon * length;
+                };
+            size_t first = result.vertices.size();
+            for (uint32_t u : loop) {
+                while (result.vertices.size() - first >= 2 && straight(result.vertices[result.vertices.size() - 2], result.vertices.back(), u)) {
+                    result.vertices.pop_back();
+                }
+                result.vertices.push_back(u);
+            }
+            // The seam where the loop closes
+            for (bool changed = true; changed && result.vertices.size() - first > 3;) {
+                size_t size = result.vertices.size();
+                changed = false;
+                if (straight(result.vertices[size - 2], result.vertices[size - 1], result.vertices[first])) {
+                    result.vertices.pop_back();
+                    changed = true;
+                }
+                else if (straight(result.vertices[size - 1], result.vertices[first], result.vertices[first + 1])) {
+                    result.vertices.erase(result.vertices.begin() + first);
+                    changed = true;
+                }
+            }
+            emit(root);
+        }
+        return result;
+    }
+}
\ No newline at end of file
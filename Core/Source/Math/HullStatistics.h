@@ -0,0 +1,151 @@
+// Work counters for the hull engines
+#pragma once
+
+#include <cstdint>
+#include <algorithm>
+
+namespace Core {
+
+    enum class HullPhase {
+        Setup,          // initial face / tetrahedron
+        Conflicts,      // initial conflict lists
+        Insertion,      // main loop: wrapping or point insertion
+        Output,         // collecting the result
+        Count
+    };
+
+    struct HullCounters {
+        uint64_t orientationTests = 0;
+        uint64_t facesCreated = 0;
+        uint64_t facesDestroyed = 0;
+        uint64_t conflictUpdates = 0;
+        uint64_t hashProbes = 0;
+        uint64_t allocations = 0;
+        uint64_t refinedTests = 0;      // orientation tests a float filter could not settle
+
+        HullCounters& operator+=(const HullCounters& other) {
+            orientationTests += other.orientationTests;
+            facesCreated += other.facesCreated;
+            facesDestroyed += other.facesDestroyed;
+            conflictUpdates += other.conflictUpdates;
+            hashProbes += other.hashProbes;
+            allocations += other.allocations;
+            refinedTests += other.refinedTests;
+            return *this;
+        }
+    };
+
+    /*
+    * Statistics policy of ConvexHullMachine, counts the work of one run per phase.
+    *
+    * How to use:
+    * HullStatistics stats;
+    * auto hull = ConvexHullMachine<double, 1e-9, HullStatistics>::incrementalFast(p, stats);
+    * stats.total().orientationTests, stats.phase(HullPhase::Insertion).facesCreated, ...
+    */
+    class HullStatistics {
+    public:
+        static constexpr bool enabled = true;
+
+        void reset() {
+            *this = HullStatistics();
+        }
+
+        void beginPhase(HullPhase phase) {
+            m_phase = phase;
+        }
+
+        void orientationTest(uint64_t count = 1) {
+            current().orientationTests += count;
+        }
+
+        void faceCreated() {
+            current().facesCreated++;
+            m_peakFaceCount = std::max(m_peakFaceCount, ++m_liveFaceCount);
+        }
+
+        void faceDestroyed(uint64_t count = 1) {
+            current().facesDestroyed += count;
+            m_liveFaceCount -= count;
+        }
+
+        void conflictUpdate(uint64_t count = 1) {
+            current().conflictUpdates += count;
+        }
+
+        void hashProbe(uint64_t count = 1) {
+            current().hashProbes += count;
+        }
+
+        void allocation(uint64_t count = 1) {
+            current().allocations += count;
+        }
+
+        void refinedTest(uint64_t count = 1) {
+            current().refinedTests += count;
+        }
+
+        // Counts the reallocation a push_back into 'container' is about to cause
+        template<typename Container>
+        void growth(const Container& container) {
+            if (container.size() == container.capacity()) {
+                current().allocations++;
+            }
+        }
+
+        const HullCounters& phase(HullPhase phase) const {
+            return m_phases[int(phase)];
+        }
+
+        HullCounters total() const {
+            HullCounters result;
+            for (const auto& counters : m_phases) {
+                result += counters;
+            }
+            return result;
+        }
+
+        uint64_t peakFaceCount() const {
+            return m_peakFaceCount;
+        }
+
+        // Bytes the engine holds right now, the largest value is kept
+        void workingSet(uint64_t bytes) {
+            m_peakWorkingSet = std::max(m_peakWorkingSet, bytes);
+        }
+
+        uint64_t peakWorkingSet() const {
+            return m_peakWorkingSet;
+        }
+
+    private:
+        HullCounters& current() {
+            return m_phases[int(m_phase)];
+        }
+
+    private:
+        HullCounters m_phases[int(HullPhase::Count)];
+        HullPhase m_phase = HullPhase::Setup;
+        uint64_t m_liveFaceCount = 0;
+        uint64_t m_peakFaceCount = 0;
+        uint64_t m_peakWorkingSet = 0;
+    };
+
+    // Default policy, every call compiles away
+    struct NoHullStatistics {
+        static constexpr bool enabled = false;
+
+        void beginPhase(HullPhase) {}
+        void orientationTest(uint64_t = 1) {}
+        void faceCreated() {}
+        void faceDestroyed(uint64_t = 1) {}
+        void conflictUpdate(uint64_t = 1) {}
+        void hashProbe(uint64_t = 1) {}
+        void allocation(uint64_t = 1) {}
+        void refinedTest(uint64_t = 1) {}
+        void workingSet(uint64_t) {}
+        template<typename Container>
+        void growth(const Container&) {}
+    };
+
+}
\ No newline at end of file
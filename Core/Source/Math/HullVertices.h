@@ -0,0 +1,232 @@
+// Vertices of the convex hull without its faces
+#pragma once
+
+#include <vector>
+#include <array>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+#include "Point3D.h"
+#include "Hull.h"
+#include "HullOptions.h"
+#include "HullStatistics.h"
+#include "Core/ThreadPool.h"
+#include "Core/Profiler.h"
+
+namespace Core {
+
+    /*
+    * Sorted indices of the points that are vertices of their convex hull.
+    *
+    * The extremes along the axes and the diagonals span an inner polytope,
+    * every point strictly inside it is dropped in one parallel pass over the
+    * input, and only the survivors are hulled. On inputs whose hull has few vertices compared
+    * to the points almost everything is culled, so the faces are never built for more than
+    * a small fraction of the points. 'options.pool' runs the passes over the input in parallel.
+    *
+    * Points that do not span D dimensions give no vertices.
+    *
+    * How to use:
+    * auto extreme = hullVertices<3, double>(points);
+    */
+    template<int D, typename T, typename Statistics = NoHullStatistics>
+        requires (!std::is_same_v<Statistics, HullOptions>)
+    std::vector<uint32_t> hullVertices(std::span<const std::array<T, D>> points, Statistics& stats, const HullOptions& options = HullOptions()) {
+        CORE_PROFILE_FUNCTION();
+        using point_t = std::array<T, D>;
+        constexpr int directionCount = D + (1 << (D - 1));
+        constexpr size_t grain = 1 << 14;
+        std::vector<uint32_t> result;
+        size_t n = points.size();
+        if (n <= D) {
+            return result;
+        }
+
+        // The axes and the diagonals, a diagonal and its opposite are one direction
+        std::array<std::array<T, D>, directionCount> directions{};
+        for (int k = 0; k < D; k++) {
+            directions[k][k] = 1;
+        }
+        for (int signs = 0; signs < 1 << (D - 1); signs++) {
+            for (int k = 0; k < D; k++) {
+                directions[D + signs][k] = signs >> k & 1 ? T(-1) : T(1);
+            }
+        }
+        auto project = [&](const point_t& q, int d) {
+            T value = 0;
+            for (int k = 0; k < D; k++) {
+                value += directions[d][k] * q[k];
+            }
+            return value;
+            };
+        auto forSlices = [&](const ThreadPool::Job& job) {
+            if (options.pool) {
+                options.pool->parallelFor(n, grain, job);
+            }
+            else {
+                job(0, n, 0);
+            }
+            };
+        int workers = options.pool ? options.pool->getWorkerCount() : 1;
+
+        // Lowest and highest point along every direction, per worker then merged
+        stats.beginPhase(HullPhase::Setup);
+        struct Extremes {
+            std::array<uint32_t, directionCount> low, high;
+            std::array<T, directionCount> lowValue, highValue;
+        };
+        std::vector<Extremes> extremes(workers);
+        for (auto& e : extremes) {
+            e.low.fill(0);
+            e.high.fill(0);
+            e.lowValue.fill(std::numeric_limits<T>::max());
+            e.highValue.fill(std::numeric_limits<T>::lowest());
+        }
+        forSlices([&](size_t begin, size_t end, int worker) {
+            Extremes& e = extremes[worker];
+            for (size_t i = begin; i < end; i++) {
+                for (int d = 0; d < directionCount; d++) {
+                    T value = project(points[i], d);
+                    if (value < e.lowValue[d]) {
+                        e.lowValue[d] = value;
+                        e.low[d] = uint32_t(i);
+                    }
+                    if (value > e.highValue[d]) {
+                        e.highValue[d] = value;
+                        e.high[d] = uint32_t(i);
+                    }
+                }
+            }
+            });
+        std::vector<uint32_t> seeds;
+        for (int d = 0; d < directionCount; d++) {
+            const Extremes* low = &extremes[0];
+            const Extremes* high = &extremes[0];
+            for (const auto& e : extremes) {
+                low = e.lowValue[d] < low->lowValue[d] ? &e : low;
+                high = e.highValue[d] > high->highValue[d] ? &e : high;
+            }
+            seeds.push_back(low->low[d]);
+            seeds.push_back(high->high[d]);
+        }
+        std::sort(seeds.begin(), seeds.end());
+        seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+        stats.orientationTest(uint64_t(n) * directionCount);
+
+        T scale = 0;
+        for (const auto& e : extremes) {
+            for (int d = 0; d < directionCount; d++) {
+                scale = std::max({ scale, std::abs(e.lowValue[d]), std::abs(e.highValue[d]) });
+            }
+        }
+        T margin = 16 * D * std::numeric_limits<T>::epsilon() * scale;
+
+        // Points strictly inside the polytope of the extremes cannot be vertices
+        std::vector<point_t> inner;
+        for (uint32_t s : seeds) {
+            inner.push_back(points[s]);
+        }
+        Hull<D, T> cull;
+        bool culling = cull.build(std::span<const point_t>(inner));
+        std::vector<uint8_t> keep(n, 1);
+        if (culling) {
+            stats.beginPhase(HullPhase::Conflicts);
+            const auto& facets = cull.facets();
+            // A ball inside the polytope settles most inner points with one test instead of one per facet
+            point_t center{};
+            for (const auto& q : inner) {
+                for (int k = 0; k < D; k++) {
+                    center[k] += q[k] / T(inner.size());
+                }
+            }
+            T radius = std::numeric_limits<T>::max();
+            for (const auto& facet : facets) {
+                T distance = facet.offset;
+                for (int k = 0; k < D; k++) {
+                    distance += facet.normal[k] * center[k];
+                }
+                radius = std::min(radius, -distance - margin);
+            }
+            T radius2 = radius > 0 ? radius * radius : T(0);
+            std::vector<uint64_t> tests(workers, 0);
+            forSlices([&](size_t begin, size_t end, int worker) {
+                uint64_t count = 0;
+                for (size_t i = begin; i < end; i++) {
+                    const point_t& q = points[i];
+                    T length2 = 0;
+                    for (int k = 0; k < D; k++) {
+                        length2 += (q[k] - center[k]) * (q[k] - center[k]);
+                    }
+                    count++;
+                    if (length2 < radius2) {
+                        keep[i] = 0;
+                        continue;
+                    }
+                    bool outside = false;
+                    for (const auto& facet : facets) {
+                        T distance = facet.offset;
+                        for (int k = 0; k < D; k++) {
+                            distance += facet.normal[k] * q[k];
+                        }
+                        count++;
+                        if (distance > -margin) {
+                            outside = true;
+                            break;
+                        }
+                    }
+                    keep[i] = outside;
+                }
+                tests[worker] += count;
+                });
+            for (uint64_t count : tests) {
+                stats.orientationTest(count);
+            }
+        }
+
+        std::vector<uint32_t> survivors;
+        std::vector<point_t> candidates;
+        for (uint32_t i = 0; i < uint32_t(n); i++) {
+            if (keep[i]) {
+                survivors.push_back(i);
+                candidates.push_back(points[i]);
+            }
+        }
+        stats.allocation(3);
+
+        Hull<D, T, Statistics> hull;
+        if (!hull.build(std::span<const point_t>(candidates), stats)) {
+            return result;
+        }
+        result = hull.vertices();
+        for (uint32_t& v : result) {
+            v = survivors[v];
+        }
+        return result;
+    }
+
+    template<int D, typename T>
+    std::vector<uint32_t> hullVertices(std::span<const std::array<T, D>> points, const HullOptions& options = HullOptions()) {
+        NoHullStatistics stats;
+        return hullVertices<D, T>(points, stats, options);
+    }
+
+    // Takes the points of the 3D engines
+    template<typename T, typename Statistics = NoHullStatistics>
+        requires (!std::is_same_v<Statistics, HullOptions>)
+    std::vector<uint32_t> hullVertices(std::span<const point3D<T>> points, Statistics& stats, const HullOptions& options = HullOptions()) {
+        std::vector<std::array<T, 3>> converted(points.size());
+        for (size_t i = 0; i < points.size(); i++) {
+            converted[i] = { points[i].x, points[i].y, points[i].z };
+        }
+        return hullVertices<3, T>(std::span<const std::array<T, 3>>(converted), stats, options);
+    }
+
+    template<typename T>
+    std::vector<uint32_t> hullVertices(std::span<const point3D<T>> points, const HullOptions& options = HullOptions()) {
+        NoHullStatistics stats;
+        return hullVertices(points, stats, options);
+    }
+}
\ No newline at end of file
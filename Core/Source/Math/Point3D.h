@@ -1,5 +1,9 @@
 #pragma once
 
+#include <cmath>
+#include <tuple>
+#include <glm/vec3.hpp>
+
 namespace Core {
     template<typename T>
     struct point3D;
@@ -7,19 +11,31 @@ namespace Core {
 
     // Dot product
     template<typename T>
-    T dot(const point3D<T>& lhs, const point3D<T>& rhs);
+    constexpr T dot(const point3D<T>& lhs, const point3D<T>& rhs) noexcept;
 
     // Cross product
     template<typename T>
-    point3D<T> cross(const point3D<T>& lhs, const point3D<T>& rhs);
+    constexpr point3D<T> cross(const point3D<T>& lhs, const point3D<T>& rhs) noexcept;
+
+    // Norm of a vector, squared length
+    template<typename T>
+    constexpr T norm(const point3D<T>& p) noexcept;
+
+    // Length of a vector
+    template<typename T>
+    T abs(const point3D<T>& p) noexcept;
 
-    // Norm of a vector :V
+    // Fused dot(p - origin, n), no temporary point
     template<typename T>
-    T norm(const point3D<T>& p);
+    constexpr T dotFrom(const point3D<T>& p, const point3D<T>& origin, const point3D<T>& n) noexcept;
 
-    // Absolute of a vector :V
+    // Fused cross(b - a, c - a), normal of the counter-clockwise triangle abc
     template<typename T>
-    double abs(const point3D<T>& p);
+    constexpr point3D<T> normalVector(const point3D<T>& a, const point3D<T>& b, const point3D<T>& c) noexcept;
+
+    // Six times the signed volume of abcd, positive when d sees abc counter-clockwise
+    template<typename T>
+    constexpr T orient(const point3D<T>& a, const point3D<T>& b, const point3D<T>& c, const point3D<T>& d) noexcept;
 
     // U == std::istream? But done this way because of fast input.
     template<typename T, typename U>
@@ -31,94 +47,173 @@ namespace Core {
 
 
 
+    /*
+    * Storage of point3D. float and double get a fourth lane w that is always 0,
+    * the 16/32-byte aligned points then fit one SSE/AVX register and the lane-wise
+    * operators below compile to a few vector instructions. Every operator writes w = 0
+    * instead of computing it, 0 * -1 or 0 * inf would leave -0 or NaN in a lane that
+    * byte-wise hashing and comparing reads.
+    */
+    template<typename T>
+    struct point3DStorage {
+        static constexpr bool padded = false;
+        T x, y, z;
+
+        constexpr point3DStorage(T _x, T _y, T _z) noexcept : x(_x), y(_y), z(_z) {
+        }
+    };
+
+    template<>
+    struct alignas(16) point3DStorage<float> {
+        static constexpr bool padded = true;
+        float x, y, z, w;
+
+        constexpr point3DStorage(float _x, float _y, float _z) noexcept : x(_x), y(_y), z(_z), w(0) {
+        }
+    };
+
+    template<>
+    struct alignas(32) point3DStorage<double> {
+        static constexpr bool padded = true;
+        double x, y, z, w;
 
+        constexpr point3DStorage(double _x, double _y, double _z) noexcept : x(_x), y(_y), z(_z), w(0) {
+        }
+    };
 
     template<typename T>
-    struct point3D {
-        T x, y, z;
+    struct point3D : point3DStorage<T> {
+        using base_t = point3DStorage<T>;
+        using base_t::x;
+        using base_t::y;
+        using base_t::z;
 
-        point3D(T _x = 0, T _y = 0, T _z = 0) : x(_x), y(_y), z(_z) {
+        constexpr point3D(T _x = 0, T _y = 0, T _z = 0) noexcept : base_t(_x, _y, _z) {
         }
 
-        point3D& operator+=(const point3D& other) {
+        template<typename U, glm::qualifier Q>
+        constexpr explicit point3D(const glm::vec<3, U, Q>& v) noexcept : base_t(T(v.x), T(v.y), T(v.z)) {
+        }
+
+        template<typename U, glm::qualifier Q>
+        constexpr explicit operator glm::vec<3, U, Q>() const noexcept {
+            return glm::vec<3, U, Q>(U(x), U(y), U(z));
+        }
+
+        constexpr point3D& operator+=(const point3D& other) noexcept {
             x += other.x;
             y += other.y;
             z += other.z;
+            if constexpr (base_t::padded) {
+                this->w = 0;
+            }
             return *this;
         }
 
-        point3D& operator-=(const point3D& other) {
+        constexpr point3D& operator-=(const point3D& other) noexcept {
             x -= other.x;
             y -= other.y;
             z -= other.z;
+            if constexpr (base_t::padded) {
+                this->w = 0;
+            }
             return *this;
         }
 
-        point3D& operator*=(const T& a) {
-            z *= a;
+        constexpr point3D& operator*=(const T& a) noexcept {
             x *= a;
             y *= a;
+            z *= a;
+            if constexpr (base_t::padded) {
+                this->w = 0;
+            }
             return *this;
         }
 
-        point3D& operator/=(const T& a) {
-            z /= a;
+        constexpr point3D& operator/=(const T& a) noexcept {
             x /= a;
             y /= a;
+            z /= a;
+            if constexpr (base_t::padded) {
+                this->w = 0;
+            }
             return *this;
         }
 
-        friend point3D operator+(const point3D& lhs, const point3D& rhs) {
+        friend constexpr point3D operator+(const point3D& lhs, const point3D& rhs) noexcept {
             return point3D(lhs) += rhs;
         }
-        friend point3D operator-(const point3D& lhs, const point3D& rhs) {
+        friend constexpr point3D operator-(const point3D& lhs, const point3D& rhs) noexcept {
             return point3D(lhs) -= rhs;
         }
-        friend point3D operator*(const point3D& lhs, const T& rhs) {
+        friend constexpr point3D operator*(const point3D& lhs, const T& rhs) noexcept {
             return point3D(lhs) *= rhs;
         }
-        friend point3D operator*(const T& lhs, const point3D& rhs) {
+        friend constexpr point3D operator*(const T& lhs, const point3D& rhs) noexcept {
             return point3D(rhs) *= lhs;
         }
-        friend point3D operator/(const point3D& lhs, const T& rhs) {
+        friend constexpr point3D operator/(const point3D& lhs, const T& rhs) noexcept {
             return point3D(lhs) /= rhs;
         }
-        point3D operator-() {
-            return -1 * *this;
+        constexpr point3D operator-() const noexcept {
+            return point3D(-x, -y, -z);
         }
 
-        friend bool operator==(const point3D& lhs, const point3D& rhs) {
+        friend constexpr bool operator==(const point3D& lhs, const point3D& rhs) noexcept {
             return std::tie(lhs.x, lhs.y, lhs.z) == std::tie(rhs.x, rhs.y, rhs.z);
         }
-        friend bool operator!=(const point3D& lhs, const point3D& rhs) {
+        friend constexpr bool operator!=(const point3D& lhs, const point3D& rhs) noexcept {
             return !(lhs == rhs);
         }
-        friend bool operator<(const point3D& lhs, const point3D& rhs) {
+        friend constexpr bool operator<(const point3D& lhs, const point3D& rhs) noexcept {
             return std::tie(lhs.x, lhs.y, lhs.z) < std::tie(rhs.x, rhs.y, rhs.z);
         }
-        friend bool operator>(const point3D& lhs, const point3D& rhs) {
+        friend constexpr bool operator>(const point3D& lhs, const point3D& rhs) noexcept {
             return std::tie(lhs.x, lhs.y, lhs.z) > std::tie(rhs.x, rhs.y, rhs.z);
         }
     };
 
+    // Same lanes as glm::vec3, drops w
+    template<typename T>
+    constexpr glm::vec<3, T> toGlm(const point3D<T>& p) noexcept {
+        return glm::vec<3, T>(p.x, p.y, p.z);
+    }
+
     template<typename T>
-    T dot(const point3D<T>& lhs, const point3D<T>& rhs) {
+    constexpr T dot(const point3D<T>& lhs, const point3D<T>& rhs) noexcept {
         return lhs.x * rhs.x + lhs.y * rhs.y + lhs.z * rhs.z;
     }
 
     template<typename T>
-    point3D<T> cross(const point3D<T>& lhs, const point3D<T>& rhs) {
+    constexpr point3D<T> cross(const point3D<T>& lhs, const point3D<T>& rhs) noexcept {
         return point3D<T>(lhs.y * rhs.z - lhs.z * rhs.y, lhs.z * rhs.x - lhs.x * rhs.z, lhs.x * rhs.y - lhs.y * rhs.x);
     }
 
     template<typename T>
-    T norm(const point3D<T>& p) {
+    constexpr T norm(const point3D<T>& p) noexcept {
         return dot(p, p);
     }
 
     template<typename T>
-    double abs(const point3D<T>& p) {
-        return sqrt(norm(p));
+    T abs(const point3D<T>& p) noexcept {
+        return static_cast<T>(std::sqrt(norm(p)));
+    }
+
+    template<typename T>
+    constexpr T dotFrom(const point3D<T>& p, const point3D<T>& origin, const point3D<T>& n) noexcept {
+        return (p.x - origin.x) * n.x + (p.y - origin.y) * n.y + (p.z - origin.z) * n.z;
+    }
+
+    template<typename T>
+    constexpr point3D<T> normalVector(const point3D<T>& a, const point3D<T>& b, const point3D<T>& c) noexcept {
+        T ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+        T vx = c.x - a.x, vy = c.y - a.y, vz = c.z - a.z;
+        return point3D<T>(uy * vz - uz * vy, uz * vx - ux * vz, ux * vy - uy * vx);
+    }
+
+    template<typename T>
+    constexpr T orient(const point3D<T>& a, const point3D<T>& b, const point3D<T>& c, const point3D<T>& d) noexcept {
+        return dotFrom(d, a, normalVector(a, b, c));
     }
 
     template<typename T, typename U>
@@ -131,4 +226,7 @@ namespace Core {
         return stream >> p.x >> p.y >> p.z;
     }
 
+    static_assert(sizeof(point3D<float>) == 16 && alignof(point3D<float>) == 16);
+    static_assert(sizeof(point3D<double>) == 32 && alignof(point3D<double>) == 32);
+    static_assert(dot(cross(point3D<int>(1, 0, 0), point3D<int>(0, 1, 0)), point3D<int>(0, 0, 1)) == 1);
 }
\ No newline at end of file
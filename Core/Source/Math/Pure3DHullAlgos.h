@@ -2,24 +2,46 @@
 #pragma once
 
 #include <vector>
+#include <span>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <random>
 #include <chrono>
 #include <cassert>
 
-#include "point3D.h"
+#include "Point3D.h"
+#include "HullStatistics.h"
+#include "HullOptions.h"
+#include "SpatialSort.h"
+#include "Core/Profiler.h"
 
 namespace Core {
 
-    // A face contains indices of its three point: a, b, c
-    // and a normal vector: n
+    // A face contains indices of its three points: a, b, c
+    // and its plane dot(n, p) + d = 0, the normal n points outwards and is not normalized.
+    // The plane comes first so a visibility test reads one record and no point.
     template<typename T>
     struct Tface {
-        int a, b, c;
         point3D<T> n;
+        T d;
+        uint32_t a, b, c;
 
-        Tface(T _a, T _b, T _c, point3D<T> _n) : a(_a), b(_b), c(_c), n(_n) {
+        constexpr Tface(uint32_t _a, uint32_t _b, uint32_t _c, const point3D<T>& _n, T _d) noexcept
+            : n(_n), d(_d), a(_a), b(_b), c(_c) {
+        }
+
+        // Plane of the counter-clockwise triangle pa, pb, pc
+        constexpr Tface(uint32_t _a, uint32_t _b, uint32_t _c, const point3D<T>& pa, const point3D<T>& pb, const point3D<T>& pc) noexcept
+            : n(normalVector(pa, pb, pc)), d(-dot(n, pa)), a(_a), b(_b), c(_c) {
+        }
+
+        // Signed distance scaled by |n|, positive outside
+        constexpr T distance(const point3D<T>& p) const noexcept {
+            return dot(n, p) + d;
         }
     };
 
@@ -29,8 +51,11 @@ namespace Core {
     * How to use:
     * auto hull = ConvexHullMachine< * type of point * >::incrementalFast( * vector of point * );
     * 'hull' contains all faces of the convex hull and its normal vector.
+    *
+    * Pass HullStatistics as 'Statistics' and a stats object to count the work done,
+    * the default NoHullStatistics costs nothing.
     */
-    template<typename T, T initialEpsilon = static_cast<T>(1e-9)>
+    template<typename T, T initialEpsilon = static_cast<T>(1e-9), typename Statistics = NoHullStatistics>
     class ConvexHullMachine {
     public:
         using point_t = point3D<T>;
@@ -41,15 +66,61 @@ namespace Core {
         }
 
         static std::vector<face_t> giftWrapping(std::vector<point_t>& p) {
-            return giftWrappingImplement(p);
+            Statistics stats;
+            return giftWrappingImplement(p, stats);
+        }
+
+        static std::vector<face_t> giftWrapping(std::vector<point_t>& p, Statistics& stats) {
+            return giftWrappingImplement(p, stats);
         }
 
         static std::vector<face_t> incremental(std::vector<point_t>& p) {
-            return incrementalImplement(p);
+            Statistics stats;
+            return incrementalImplement(p, stats);
+        }
+
+        static std::vector<face_t> incremental(std::vector<point_t>& p, Statistics& stats) {
+            return incrementalImplement(p, stats);
         }
 
         static std::vector<face_t> incrementalFast(std::vector<point_t>& p) {
-            return incrementalFastImplement(p);
+            Statistics stats;
+            return incrementalFastImplement(p, stats);
+        }
+
+        static std::vector<face_t> incrementalFast(std::vector<point_t>& p, Statistics& stats) {
+            return incrementalFastImplement(p, stats);
+        }
+
+        // 'options' picks the insertion order, InsertionOrder::Brio pays off on large inputs
+        static std::vector<face_t> incrementalFast(std::vector<point_t>& p, const HullOptions& options) {
+            Statistics stats;
+            return incrementalFast(p, stats, options);
+        }
+
+        static std::vector<face_t> incrementalFast(std::vector<point_t>& p, Statistics& stats, const HullOptions& options) {
+            if constexpr (std::is_same_v<T, float>) {
+                if (options.precision == Precision::Filtered) {
+                    return incrementalFastImplement<true>(p, stats, options);
+                }
+            }
+            return incrementalFastImplement(p, stats, options);
+        }
+
+        /*
+        * Approximate hull for huge inputs, 'epsilon' is relative to the bounding box diagonal.
+        * Keeps the lowest and highest point of every column of a grid with cells of
+        * epsilon * diagonal / sqrt(2) and hulls them with incrementalFast, 'p' is replaced by the kept points.
+        * 'error' receives the achieved Hausdorff distance: every input point lies within it of the hull.
+        * It never exceeds epsilon * diagonal and is 0 when the grid would not shrink the input.
+        */
+        static std::vector<face_t> approximate(std::vector<point_t>& p, T epsilon, T& error) {
+            Statistics stats;
+            return approximateImplement(p, epsilon, error, stats);
+        }
+
+        static std::vector<face_t> approximate(std::vector<point_t>& p, T epsilon, T& error, Statistics& stats) {
+            return approximateImplement(p, epsilon, error, stats);
         }
 
 
@@ -70,11 +141,9 @@ namespace Core {
             return true;
         }
 
-        static point_t normalVector(const point_t& a, const point_t& b, const point_t& c) {
-            return cross(b - a, c - a);
-        }
-
-        static void initialFace(std::vector<point_t>& p) {
+        static void initialFace(std::vector<point_t>& p, Statistics& stats) {
+            CORE_PROFILE_SCOPE("ConvexHullMachine::initialFace");
+            stats.beginPhase(HullPhase::Setup);
             std::sort(p.begin(), p.end());
             p.erase(std::unique(p.begin(), p.end()), p.end());
 
@@ -86,6 +155,7 @@ namespace Core {
             for (int i = 2; i < n; i++) {
                 auto v = p[1] - p[0];
                 auto nv = p[i] - p[1];
+                stats.orientationTest();
                 if (cross(v, nv).z > EPSILON) {
                     std::swap(p[i], p[1]);
                 }
@@ -96,6 +166,7 @@ namespace Core {
             auto h = cross(v01, normalVector(p[0], p[1], p[2]));
             for (int i = 3; i < n; i++) {
                 auto new_h = cross(v01, normalVector(p[0], p[1], p[i]));
+                stats.orientationTest();
                 if (isZero(new_h)) {
                     continue;
                 }
@@ -110,22 +181,26 @@ namespace Core {
             }
             auto n012 = normalVector(p[0], p[1], p[2]);
             for (int i = 3; i < n; i++) {
-                if (dot(p[i] - p[0], n012) < -EPSILON) {
+                stats.orientationTest();
+                if (dotFrom(p[i], p[0], n012) < -EPSILON) {
                     std::swap(p[0], p[1]);
                     break;
                 }
             }
             for (int i = 4; i < n; i++) {
-                assert(dot(p[i] - p[0], n012) > -EPSILON);
-                if (std::abs(dot(p[i] - p[0], n012)) > EPSILON) {
+                assert(dotFrom(p[i], p[0], n012) > -EPSILON);
+                stats.orientationTest();
+                if (std::abs(dotFrom(p[i], p[0], n012)) > EPSILON) {
                     std::swap(p[i], p[3]);
                     break;
                 }
             }
-            assert("All points are coplanar" && std::abs(dot(p[3] - p[0], n012)) > EPSILON);
+            assert("All points are coplanar" && std::abs(dotFrom(p[3], p[0], n012)) > EPSILON);
         }
 
-        static void initialTetrahedron(std::vector<point_t>& p) {
+        static void initialTetrahedron(std::vector<point_t>& p, Statistics& stats) {
+            CORE_PROFILE_SCOPE("ConvexHullMachine::initialTetrahedron");
+            stats.beginPhase(HullPhase::Setup);
             int n = int(p.size());
             assert(n > 3);
             // Make sure that first 4 points are not coplanar
@@ -136,18 +211,20 @@ namespace Core {
                 }
             }
             for (int i = 2; i < n; i++) {
+                stats.orientationTest();
                 if (!isZero(normalVector(p[0], p[1], p[i]))) {
                     std::swap(p[i], p[2]);
                     break;
                 }
             }
             for (int i = 3; i < n; i++) {
-                if (std::abs(dot(p[i] - p[0], normalVector(p[0], p[1], p[2]))) > EPSILON) {
+                stats.orientationTest();
+                if (std::abs(dotFrom(p[i], p[0], normalVector(p[0], p[1], p[2]))) > EPSILON) {
                     std::swap(p[i], p[3]);
                     break;
                 }
             }
-            assert("All points are coplanar" && std::abs(dot(p[3] - p[0], normalVector(p[0], p[1], p[2]))) > EPSILON);
+            assert("All points are coplanar" && std::abs(dotFrom(p[3], p[0], normalVector(p[0], p[1], p[2]))) > EPSILON);
         }
 
         static std::vector<face_t> bruteForceImplement(std::vector<point_t>& p) {
@@ -161,8 +238,9 @@ namespace Core {
             // TODO: nhường cho thằng Thăng
         }
 
-        static std::vector<face_t> giftWrappingImplement(std::vector<point_t>& p) {
-            initialFace(p);
+        static std::vector<face_t> giftWrappingImplement(std::vector<point_t>& p, Statistics& stats) {
+            CORE_PROFILE_SCOPE("ConvexHullMachine::giftWrapping");
+            initialFace(p, stats);
             int n = int(p.size());
 
             std::vector<face_t> faces;
@@ -171,87 +249,341 @@ namespace Core {
                 return a * int64_t(1e9) + b;
                 };
             auto addFace = [&](int a, int b, int c) {
-                faces.emplace_back(a, b, c, cross(p[b] - p[a], p[c] - p[a]));
+                stats.faceCreated();
+                stats.growth(faces);
+                faces.emplace_back(a, b, c, p[a], p[b], p[c]);
                 edges.insert(h(a, b));
                 edges.insert(h(b, c));
                 edges.insert(h(c, a));
+                stats.hashProbe(3);
+                stats.allocation(3);
                 };
             addFace(0, 1, 2);
 
-            for (int i = 0; i < int(faces.size()); i++) {
-                int x[4] = { faces[i].a, faces[i].b, faces[i].c, faces[i].a };
-                auto fn = faces[i].n;
-                for (int k = 0; k < 3; k++) {
-                    int a = x[k];
-                    int b = x[k + 1];
-                    if (!edges.contains(h(b, a))) {
-                        // Tricky part :)
-                        auto ab = p[b] - p[a];
-                        auto v = cross(ab, cross(ab, p[0] - p[b]));
-                        int mnID = 0;
-                        for (int j = 1; j < n; j++) {
-                            auto q = cross(ab, p[j] - p[b]);
-                            // If faces[i] and p[j] is coplanar 
-                            // and p[j] is on the left of 'ab' when you are looking in the 'fn' direction
-                            if (std::abs(dot(p[j] - p[b], fn)) < EPSILON && dot(q, fn) < -EPSILON) {
-                                mnID = j;
-                                break;
-                            }
-                            auto nv = cross(ab, q);
-                            // If 'nv' is on the right of 'v' when you are looking from 'a' to 'b'
-                            if (dot(cross(nv, v), ab) > EPSILON) {
-                                v = nv;
-                                mnID = j;
+            {
+                CORE_PROFILE_SCOPE("ConvexHullMachine::wrap");
+                stats.beginPhase(HullPhase::Insertion);
+                for (int i = 0; i < int(faces.size()); i++) {
+                    // Copied, addFace may reallocate 'faces'
+                    const face_t face = faces[i];
+                    int x[4] = { int(face.a), int(face.b), int(face.c), int(face.a) };
+                    for (int k = 0; k < 3; k++) {
+                        int a = x[k];
+                        int b = x[k + 1];
+                        stats.hashProbe();
+                        if (!edges.contains(h(b, a))) {
+                            // Tricky part :)
+                            auto ab = p[b] - p[a];
+                            auto v = cross(ab, cross(ab, p[0] - p[b]));
+                            int mnID = 0;
+                            for (int j = 1; j < n; j++) {
+                                auto q = cross(ab, p[j] - p[b]);
+                                stats.orientationTest(2);
+                                // If faces[i] and p[j] is coplanar 
+                                // and p[j] is on the left of 'ab' when you are looking in the 'face.n' direction
+                                if (std::abs(face.distance(p[j])) < EPSILON && dot(q, face.n) < -EPSILON) {
+                                    mnID = j;
+                                    break;
+                                }
+                                auto nv = cross(ab, q);
+                                // If 'nv' is on the right of 'v' when you are looking from 'a' to 'b'
+                                if (dot(cross(nv, v), ab) > EPSILON) {
+                                    v = nv;
+                                    mnID = j;
+                                }
                             }
+                            addFace(b, a, mnID);
                         }
-                        addFace(b, a, mnID);
                     }
                 }
             }
             return faces;
         }
 
-        static std::vector<face_t> incrementalImplement(std::vector<point_t>& p) {
-            initialTetrahedron(p);
+        static std::vector<face_t> incrementalImplement(std::vector<point_t>& p, Statistics& stats) {
+            CORE_PROFILE_SCOPE("ConvexHullMachine::incremental");
+            initialTetrahedron(p, stats);
             int n = int(p.size());
 
             std::vector<face_t> faces;
             std::vector<std::vector<bool>> edges(n, std::vector<bool>(n));
+            stats.allocation(n + 1);
 
             auto addFace = [&](int a, int b, int c) {
-                faces.emplace_back(a, b, c, cross(p[b] - p[a], p[c] - p[a]));
+                stats.faceCreated();
+                stats.growth(faces);
+                faces.emplace_back(a, b, c, p[a], p[b], p[c]);
                 edges[a][b] = edges[b][c] = edges[c][a] = true;
                 };
             addFace(0, 1, 2);
             addFace(0, 2, 1);
 
-            for (int i = 3; i < n; i++) {
-                faces.erase(std::remove_if(faces.begin(), faces.end(), [&](const auto& f) {
-                    // If this face is visible to p[i], remove it
-                    if (dot(p[i] - p[f.a], f.n) > EPSILON) {
-                        edges[f.a][f.b] = edges[f.b][f.c] = edges[f.c][f.a] = false;
-                        return true;
+            {
+                CORE_PROFILE_SCOPE("ConvexHullMachine::insert");
+                stats.beginPhase(HullPhase::Insertion);
+                for (int i = 3; i < n; i++) {
+                    faces.erase(std::remove_if(faces.begin(), faces.end(), [&](const auto& f) {
+                        // If this face is visible to p[i], remove it
+                        stats.orientationTest();
+                        if (f.distance(p[i]) > EPSILON) {
+                            stats.faceDestroyed();
+                            edges[f.a][f.b] = edges[f.b][f.c] = edges[f.c][f.a] = false;
+                            return true;
+                        }
+                        return false;
+                        }), faces.end());
+
+                    int sz = int(faces.size());
+                    for (int j = 0; j < sz; j++) {
+                        int x[4] = { int(faces[j].a), int(faces[j].b), int(faces[j].c), int(faces[j].a) };
+                        for (int k = 0; k < 3; k++) {
+                            if (!edges[x[k + 1]][x[k]]) {
+                                addFace(x[k + 1], x[k], i);
+                            }
+                        }
                     }
-                    return false;
-                    }), faces.end());
+                }
+            }
+            stats.beginPhase(HullPhase::Output);
+            return faces;
+        }
 
-                int sz = int(faces.size());
-                for (int j = 0; j < sz; j++) {
-                    int x[4] = { faces[j].a, faces[j].b, faces[j].c, faces[j].a };
-                    for (int k = 0; k < 3; k++) {
-                        if (!edges[x[k + 1]][x[k]]) {
-                            addFace(x[k + 1], x[k], i);
+        static std::vector<face_t> approximateImplement(std::vector<point_t>& p, T epsilon, T& error, Statistics& stats) {
+            CORE_PROFILE_SCOPE("ConvexHullMachine::approximate");
+            stats.beginPhase(HullPhase::Setup);
+            error = 0;
+            int n = int(p.size());
+            point_t lo = p[0], hi = p[0];
+            for (const auto& q : p) {
+                lo = point_t(std::min(lo.x, q.x), std::min(lo.y, q.y), std::min(lo.z, q.z));
+                hi = point_t(std::max(hi.x, q.x), std::max(hi.y, q.y), std::max(hi.z, q.z));
+            }
+
+            // Columns run along the longest box axis 'w', the grid spans the other two
+            auto coord = [](const point_t& q, int axis) {
+                return axis == 0 ? q.x : axis == 1 ? q.y : q.z;
+                };
+            point_t extent = hi - lo;
+            int w = extent.x >= extent.y && extent.x >= extent.z ? 0 : extent.y >= extent.z ? 1 : 2;
+            int u = (w + 1) % 3, v = (w + 2) % 3;
+            double cell = double(epsilon) * std::sqrt(double(norm(extent))) / std::sqrt(2.0);
+            double columnsU = std::floor(double(coord(extent, u)) / cell) + 1;
+            double columnsV = std::floor(double(coord(extent, v)) / cell) + 1;
+            if (!(cell > 0) || columnsU * columnsV * 2 >= double(n)) {
+                return incrementalFastImplement(p, stats);
+            }
+
+            int nu = int(columnsU), nv = int(columnsV);
+            auto column = [&](const point_t& q) {
+                int cu = std::min(int(double(coord(q, u) - coord(lo, u)) / cell), nu - 1);
+                int cv = std::min(int(double(coord(q, v) - coord(lo, v)) / cell), nv - 1);
+                return cu * nv + cv;
+                };
+            std::vector<std::pair<int, int>> columns(size_t(nu) * nv, { -1, -1 });
+            stats.allocation();
+            for (int i = 0; i < n; i++) {
+                auto& [low, high] = columns[column(p[i])];
+                T height = coord(p[i], w);
+                if (low < 0 || height < coord(p[low], w)) {
+                    low = i;
+                }
+                if (high < 0 || height > coord(p[high], w)) {
+                    high = i;
+                }
+            }
+
+            std::vector<point_t> kept;
+            for (const auto& [low, high] : columns) {
+                if (low >= 0) {
+                    kept.push_back(p[low]);
+                    if (high != low) {
+                        kept.push_back(p[high]);
+                    }
+                }
+            }
+            if (kept.size() < 4) {
+                return incrementalFastImplement(p, stats);
+            }
+            std::vector<point_t> input;
+            input.swap(p);
+            p.swap(kept);
+            auto faces = incrementalFastImplement(p, stats);
+
+            // A column whose whole cell box is inside the hull holds no error.
+            // Only checked while it costs less than a few passes over the input
+            std::vector<bool> inside(columns.size());
+            if (double(p.size()) * 4.0 * double(faces.size()) <= 8.0 * double(n)) {
+                for (int cu = 0; cu < nu; cu++) {
+                    for (int cv = 0; cv < nv; cv++) {
+                        const auto& [low, high] = columns[cu * nv + cv];
+                        if (low < 0) {
+                            continue;
                         }
+                        bool all = true;
+                        for (int corner = 0; corner < 8 && all; corner++) {
+                            T c[3];
+                            c[u] = coord(lo, u) + T(cell * (cu + (corner & 1)));
+                            c[v] = coord(lo, v) + T(cell * (cv + (corner >> 1 & 1)));
+                            c[w] = coord(input[corner >> 2 ? high : low], w);
+                            point_t q(c[0], c[1], c[2]);
+                            all = std::all_of(faces.begin(), faces.end(), [&](const face_t& f) {
+                                stats.orientationTest();
+                                return f.distance(q) <= 0;
+                                });
+                        }
+                        inside[cu * nv + cv] = all;
                     }
                 }
             }
+
+            // Every other point lies between the lowest and highest point of its column,
+            // its distance to that segment bounds its distance to the hull
+            T error2 = 0;
+            for (const auto& q : input) {
+                int c = column(q);
+                if (inside[c]) {
+                    continue;
+                }
+                const point_t& a = input[columns[c].first];
+                point_t ab = input[columns[c].second] - a;
+                T length2 = norm(ab);
+                T t = length2 > 0 ? std::clamp(dotFrom(q, a, ab) / length2, T(0), T(1)) : T(0);
+                error2 = std::max(error2, norm(q - (a + ab * t)));
+            }
+            error = static_cast<T>(std::sqrt(double(error2)));
             return faces;
         }
 
-        static std::vector<face_t> incrementalFastImplement(std::vector<point_t>& p) {
-            initialTetrahedron(p);
-            std::shuffle(p.begin() + 4, p.end(), std::mt19937_64((unsigned int)std::chrono::steady_clock::now().time_since_epoch().count()));
+        // Points after the initial tetrahedron are inserted in array order
+        static void orderInsertions(std::vector<point_t>& p, const HullOptions& options) {
+            CORE_PROFILE_SCOPE("ConvexHullMachine::shuffle");
+            uint64_t seed = options.seed ? options.seed : uint64_t(std::chrono::steady_clock::now().time_since_epoch().count());
+            if (options.order == InsertionOrder::Shuffle) {
+                std::shuffle(p.begin() + 4, p.end(), std::mt19937_64(seed));
+                return;
+            }
+            std::vector<uint32_t> order;
+            brioOrder(std::span<const point_t>(p.data() + 4, p.size() - 4), order, seed, options.pool);
+            std::vector<point_t> sorted;
+            sorted.reserve(order.size());
+            for (uint32_t i : order) {
+                sorted.push_back(p[4 + i]);
+            }
+            std::copy(sorted.begin(), sorted.end(), p.begin() + 4);
+        }
+
+        // 6 times the signed volume of abcd in double, the reference of the filtered tests
+        static double orientDouble(const point_t& a, const point_t& b, const point_t& c, const point_t& d) {
+            double ux = double(b.x) - a.x, uy = double(b.y) - a.y, uz = double(b.z) - a.z;
+            double vx = double(c.x) - a.x, vy = double(c.y) - a.y, vz = double(c.z) - a.z;
+            double wx = double(d.x) - a.x, wy = double(d.y) - a.y, wz = double(d.z) - a.z;
+            return (uy * vz - uz * vy) * wx + (uz * vx - ux * vz) * wy + (ux * vy - uy * vx) * wz;
+        }
+
+        /*
+        * Runs incrementalFastRun() and, when the working set outgrows options.memoryBudget, hulls
+        * quarters of the points on their own, keeps only their vertices and hulls those instead.
+        * 'p' is then replaced by the kept points. A split that keeps every point cannot save
+        * memory, the points are hulled in one run over the budget.
+        */
+        template<bool filtered = false>
+        static std::vector<face_t> incrementalFastImplement(std::vector<point_t>& p, Statistics& stats, const HullOptions& options = HullOptions(), size_t heldBytes = 0) {
+            CORE_PROFILE_SCOPE("ConvexHullMachine::incrementalFast");
+            bool exceeded = false;
+            auto faces = incrementalFastRun<filtered>(p, stats, options, heldBytes, exceeded);
+            if (!exceeded) {
+                return faces;
+            }
+            CORE_PROFILE_SCOPE("ConvexHullMachine::chunked");
+            size_t n = p.size();
+            size_t chunk = (n + 3) / 4;
+            std::vector<point_t> kept, part;
+            std::vector<bool> vertex;
+            for (size_t begin = 0; begin < n; begin += chunk) {
+                part.assign(p.begin() + begin, p.begin() + std::min(n, begin + chunk));
+                if (!spansSpace(part)) {
+                    kept.insert(kept.end(), part.begin(), part.end());
+                    continue;
+                }
+                size_t held = heldBytes + (p.capacity() + kept.capacity() + part.capacity()) * sizeof(point_t);
+                auto partFaces = incrementalFastImplement<filtered>(part, stats, options, held);
+                vertex.assign(part.size(), false);
+                for (const auto& f : partFaces) {
+                    vertex[f.a] = vertex[f.b] = vertex[f.c] = true;
+                }
+                for (size_t i = 0; i < part.size(); i++) {
+                    if (vertex[i]) {
+                        kept.push_back(part[i]);
+                    }
+                }
+            }
+            HullOptions merge = options;
+            if (kept.size() == n) {
+                merge.memoryBudget = 0;
+            }
+            p.swap(kept);
+            return incrementalFastImplement<filtered>(p, stats, merge, heldBytes);
+        }
+
+        // Whether incrementalFastRun() can start: 4 points not on one plane
+        static bool spansSpace(const std::vector<point_t>& p) {
             int n = int(p.size());
+            int i = 1;
+            while (i < n && p[i] == p[0]) {
+                i++;
+            }
+            int j = i + 1;
+            while (j < n && isZero(normalVector(p[0], p[i], p[j]))) {
+                j++;
+            }
+            if (j >= n) {
+                return false;
+            }
+            auto normal = normalVector(p[0], p[i], p[j]);
+            for (int k = j + 1; k < n; k++) {
+                if (std::abs(dotFrom(p[k], p[0], normal)) > EPSILON) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /*
+        * 'filtered': face.distance(q) is computed in T and trusted only when it is further from the
+        * threshold than its forward error bound, 24 * eps * max|coordinate| * sum of |products| in the
+        * normal, which covers the rounding of the edges, the cross product, both dot products and
+        * the comparison. The other tests are decided by orientDouble().
+        *
+        * The faces seen by a point are freed once it is inserted: their edges and their ids in the
+        * conflict lists of later points are removed, and the next new faces take over their slots and
+        * conflict lists. The working set therefore follows the live hull instead of every face ever made.
+        * It is reported through stats.workingSet() with 'heldBytes' of the caller's buffers added,
+        * 'exceeded' is set and the run stops as soon as it passes options.memoryBudget. The budget is
+        * checked before the initial conflict lists from a lower bound of their size, then after them
+        * and after every insertion, so it is a soft limit: a run may pass it by one step's growth.
+        */
+        template<bool filtered>
+        static std::vector<face_t> incrementalFastRun(std::vector<point_t>& p, Statistics& stats, const HullOptions& options, size_t heldBytes, bool& exceeded) {
+            initialTetrahedron(p, stats);
+            orderInsertions(p, options);
+            int n = int(p.size());
+
+            // The initial conflict lists hold every point at least twice, a run that cannot fit them is not started
+            size_t initialBytes = heldBytes + p.capacity() * sizeof(point_t)
+                + size_t(n) * (sizeof(std::vector<int>) + 2 * sizeof(int));
+            if (options.memoryBudget != 0 && initialBytes > options.memoryBudget) {
+                exceeded = true;
+                return {};
+            }
+
+            T boundScale = 0;
+            if constexpr (filtered) {
+                for (const auto& q : p) {
+                    boundScale = std::max({ boundScale, std::abs(q.x), std::abs(q.y), std::abs(q.z) });
+                }
+                boundScale *= 24 * std::numeric_limits<T>::epsilon();
+            }
+            std::vector<T> bounds;
 
             // Hash function for two integers
             auto h = [&](int a, int b) {
@@ -260,76 +592,212 @@ namespace Core {
 
             std::vector<face_t> faces;
             std::vector<int> alive; // faces[i] alive untill alive[i]
+            std::vector<int> freeSlots;
             std::unordered_map<int64_t, int> edges;
             std::vector<std::vector<int>> Pconflict(n);
             std::vector<std::vector<int>> Fconflict;
 
+            // Bytes of the conflict lists, followed through their capacity
+            size_t conflictBytes = 0;
+            auto resized = [&](const std::vector<int>& list, size_t capacity) {
+                conflictBytes += (list.capacity() - capacity) * sizeof(int);
+                };
+            auto workingSet = [&]() {
+                size_t edgeNode = sizeof(std::pair<const int64_t, int>) + 2 * sizeof(void*);
+                return heldBytes + conflictBytes
+                    + p.capacity() * sizeof(point_t)
+                    + faces.capacity() * sizeof(face_t)
+                    + (alive.capacity() + freeSlots.capacity()) * sizeof(int)
+                    + bounds.capacity() * sizeof(T)
+                    + (Pconflict.capacity() + Fconflict.capacity()) * sizeof(std::vector<int>)
+                    + edges.size() * edgeNode + edges.bucket_count() * sizeof(void*);
+                };
+            auto overBudget = [&]() {
+                size_t bytes = workingSet();
+                stats.workingSet(bytes);
+                return options.memoryBudget != 0 && bytes > options.memoryBudget;
+                };
+
             auto addFace = [&](int a, int b, int c) {
-                int id = int(faces.size());
-                alive.push_back(n);
-                Fconflict.emplace_back(0);
-                faces.emplace_back(a, b, c, cross(p[b] - p[a], p[c] - p[a]));
+                int id;
+                stats.faceCreated();
+                if (!freeSlots.empty()) {
+                    id = freeSlots.back();
+                    freeSlots.pop_back();
+                    alive[id] = n;
+                    faces[id] = face_t(a, b, c, p[a], p[b], p[c]);
+                }
+                else {
+                    id = int(faces.size());
+                    stats.growth(faces);
+                    stats.growth(alive);
+                    stats.growth(Fconflict);
+                    alive.push_back(n);
+                    Fconflict.emplace_back(0);
+                    faces.emplace_back(a, b, c, p[a], p[b], p[c]);
+                }
+                if constexpr (filtered) {
+                    point_t u = p[b] - p[a], v = p[c] - p[a];
+                    T products = std::abs(u.y * v.z) + std::abs(u.z * v.y) + std::abs(u.z * v.x)
+                        + std::abs(u.x * v.z) + std::abs(u.x * v.y) + std::abs(u.y * v.x);
+                    if (size_t(id) < bounds.size()) {
+                        bounds[id] = boundScale * products;
+                    }
+                    else {
+                        bounds.push_back(boundScale * products);
+                    }
+                }
+                size_t edgeCount = edges.size();
                 edges[h(a, b)] = edges[h(b, c)] = edges[h(c, a)] = id;
+                stats.hashProbe(3);
+                stats.allocation(edges.size() - edgeCount);
                 return id;
                 };
 
+            // Sign of faces[fid].distance(p[q]) - threshold
+            auto side = [&](int fid, int q, T threshold) {
+                const face_t& face = faces[fid];
+                T d = face.distance(p[q]) - threshold;
+                if constexpr (filtered) {
+                    if (std::abs(d) <= bounds[fid]) {
+                        stats.refinedTest();
+                        return T(orientDouble(p[face.a], p[face.b], p[face.c], p[q]) - double(threshold));
+                    }
+                }
+                return d;
+                };
+
             addFace(0, 1, 2);
             addFace(0, 2, 1);
 
-            for (int j = 0; j < 2; j++) {
-                for (int i = 3; i < n; i++) {
-                    auto d = dot(p[i] - p[faces[j].a], faces[j].n);
-                    if (d > EPSILON) {
-                        Pconflict[i].push_back(j);
-                    }
-                    if (d >= -EPSILON) {
-                        Fconflict[j].push_back(i);
+            {
+                CORE_PROFILE_SCOPE("ConvexHullMachine::initialConflicts");
+                stats.beginPhase(HullPhase::Conflicts);
+                for (int j = 0; j < 2; j++) {
+                    size_t fCapacity = Fconflict[j].capacity();
+                    for (int i = 3; i < n; i++) {
+                        stats.orientationTest(2);
+                        if (side(j, i, EPSILON) > 0) {
+                            stats.conflictUpdate();
+                            stats.growth(Pconflict[i]);
+                            size_t capacity = Pconflict[i].capacity();
+                            Pconflict[i].push_back(j);
+                            resized(Pconflict[i], capacity);
+                        }
+                        if (side(j, i, -EPSILON) >= 0) {
+                            stats.conflictUpdate();
+                            stats.growth(Fconflict[j]);
+                            Fconflict[j].push_back(i);
+                        }
                     }
+                    resized(Fconflict[j], fCapacity);
                 }
             }
+            if (overBudget()) {
+                exceeded = true;
+                return {};
+            }
 
-            for (int i = 3; i < n; i++) {
-                Pconflict[i].erase(std::remove_if(Pconflict[i].begin(), Pconflict[i].end(), [&](int fid) {
-                    return alive[fid] == n ? !(alive[fid] = i) : true;
-                    }), Pconflict[i].end());
-
-                for (int fid : Pconflict[i]) {
-                    int x[4] = { faces[fid].a, faces[fid].b, faces[fid].c, faces[fid].a };
-                    for (int k = 0; k < 3; k++) {
-                        int a = x[k];
-                        int b = x[k + 1];
-                        auto it = edges.find(h(b, a));
-                        if (it == edges.end()) { // No faces have been deleted before, so this section is meaningless. Fix it one day...
-                            edges.erase(h(a, b));
-                            continue;
+            {
+                CORE_PROFILE_SCOPE("ConvexHullMachine::insert");
+                stats.beginPhase(HullPhase::Insertion);
+                for (int i = 3; i < n; i++) {
+                    Pconflict[i].erase(std::remove_if(Pconflict[i].begin(), Pconflict[i].end(), [&](int fid) {
+                        if (alive[fid] != n) {
+                            return true;
                         }
+                        stats.faceDestroyed();
+                        alive[fid] = i;
+                        return false;
+                        }), Pconflict[i].end());
+
+                    for (int fid : Pconflict[i]) {
+                        int x[4] = { int(faces[fid].a), int(faces[fid].b), int(faces[fid].c), int(faces[fid].a) };
+                        for (int k = 0; k < 3; k++) {
+                            int a = x[k];
+                            int b = x[k + 1];
+                            auto it = edges.find(h(b, a));
+                            stats.hashProbe();
+                            if (it == edges.end()) { // A closed hull has every twin, only a mesh left open by a degenerate step gets here
+                                stats.hashProbe();
+                                edges.erase(h(a, b));
+                                continue;
+                            }
 
-                        int adjId = it->second;
-                        if (alive[adjId] > i) {
-                            int newFid = addFace(a, b, i);
-
-                            // Merge two set of two adjacent faces
-                            std::set_union(Fconflict[fid].begin(), Fconflict[fid].end(),
-                                Fconflict[adjId].begin(), Fconflict[adjId].end(),
-                                std::back_inserter(Fconflict[newFid]));
-
-                            // Remove invisible point
-                            Fconflict[newFid].erase(std::remove_if(Fconflict[newFid].begin(), Fconflict[newFid].end(), [&](int pid) {
-                                return !(pid > i && dot(p[pid] - p[faces[newFid].a], faces[newFid].n) > EPSILON);
-                                }), Fconflict[newFid].end());
+                            int adjId = it->second;
+                            if (alive[adjId] > i) {
+                                int newFid = addFace(a, b, i);
+
+                                // Merge two set of two adjacent faces
+                                size_t capacity = Fconflict[newFid].capacity();
+                                std::set_union(Fconflict[fid].begin(), Fconflict[fid].end(),
+                                    Fconflict[adjId].begin(), Fconflict[adjId].end(),
+                                    std::back_inserter(Fconflict[newFid]));
+                                stats.allocation(Fconflict[newFid].capacity() > capacity ? 1 : 0);
+
+                                // Remove invisible point, the candidates are sorted so 'p' is read front to back
+                                Fconflict[newFid].erase(std::remove_if(Fconflict[newFid].begin(), Fconflict[newFid].end(), [&](int pid) {
+                                    if (pid <= i) {
+                                        return true;
+                                    }
+                                    stats.orientationTest();
+                                    return !(side(newFid, pid, EPSILON) > 0);
+                                    }), Fconflict[newFid].end());
+                                resized(Fconflict[newFid], capacity);
+
+                                // Inverse mapping
+                                stats.conflictUpdate(Fconflict[newFid].size());
+                                for (int pid : Fconflict[newFid]) {
+                                    stats.growth(Pconflict[pid]);
+                                    size_t pCapacity = Pconflict[pid].capacity();
+                                    Pconflict[pid].push_back(newFid);
+                                    resized(Pconflict[pid], pCapacity);
+                                }
+                            }
+                        }
+                    }
 
-                            // Inverse mapping
-                            for (int pid : Fconflict[newFid]) {
-                                Pconflict[pid].push_back(newFid);
+                    // The faces p[i] saw are gone for good, their slots and conflict lists go to the next new faces
+                    for (int fid : Pconflict[i]) {
+                        for (int pid : Fconflict[fid]) {
+                            if (pid <= i) {
+                                continue;
+                            }
+                            auto& list = Pconflict[pid];
+                            auto found = std::find(list.begin(), list.end(), fid);
+                            if (found != list.end()) {
+                                *found = list.back();
+                                list.pop_back();
                             }
                         }
+                        const face_t& face = faces[fid];
+                        for (int64_t key : { h(face.a, face.b), h(face.b, face.c), h(face.c, face.a) }) {
+                            auto it = edges.find(key);
+                            stats.hashProbe();
+                            if (it != edges.end() && it->second == fid) {
+                                edges.erase(it);
+                            }
+                        }
+                        Fconflict[fid].clear();
+                        stats.growth(freeSlots);
+                        freeSlots.push_back(fid);
+                    }
+                    conflictBytes -= Pconflict[i].capacity() * sizeof(int);
+                    std::vector<int>().swap(Pconflict[i]);
+                    if (overBudget()) {
+                        exceeded = true;
+                        return {};
                     }
                 }
             }
             std::vector<face_t> ret;
-            for (int i = 0; i < int(faces.size()); i++) {
-                if (alive[i] == n) {
-                    ret.push_back(std::move(faces[i]));
+            {
+                CORE_PROFILE_SCOPE("ConvexHullMachine::collect");
+                stats.beginPhase(HullPhase::Output);
+                for (int i = 0; i < int(faces.size()); i++) {
+                    if (alive[i] == n) {
+                        ret.push_back(std::move(faces[i]));
+                    }
                 }
             }
             return ret;
@@ -0,0 +1,88 @@
+#include "SpatialSort.h"
+
+namespace Core {
+
+    static uint64_t spreadBits(uint32_t v)
+    {
+        uint64_t x = v & 0x1FFFFF;
+        x = (x | x << 32) & 0x1F00000000FFFFull;
+        x = (x | x << 16) & 0x1F0000FF0000FFull;
+        x = (x | x << 8) & 0x100F00F00F00F00Full;
+        x = (x | x << 4) & 0x10C30C30C30C30C3ull;
+        x = (x | x << 2) & 0x1249249249249249ull;
+        return x;
+    }
+
+    uint64_t mortonKey(uint32_t x, uint32_t y, uint32_t z)
+    {
+        return spreadBits(x) | spreadBits(y) << 1 | spreadBits(z) << 2;
+    }
+
+    void radixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values, ThreadPool* pool)
+    {
+        CORE_PROFILE_FUNCTION();
+        constexpr int radix = 256;
+        size_t n = keys.size();
+        // Small inputs are not worth splitting
+        int slices = pool && n >= 1 << 16 ? pool->getWorkerCount() : 1;
+        size_t slice = (n + slices - 1) / slices;
+        auto forSlices = [&](const ThreadPool::Job& job)
+        {
+            if (slices > 1)
+                pool->parallelFor(slices, 1, job);
+            else
+                job(0, 1, 0);
+        };
+
+        std::vector<uint64_t> keyBuffer(n);
+        std::vector<uint32_t> valueBuffer(n);
+        // counts[s * radix + d]: keys of slice s with digit d, then where slice s writes digit d
+        std::vector<size_t> counts(size_t(slices) * radix);
+        uint64_t differing = 0;
+        for (uint64_t key : keys)
+            differing |= key ^ keys[0];
+
+        for (int shift = 0; shift < 64; shift += 8)
+        {
+            if ((differing >> shift & 0xFF) == 0)
+                continue;
+            std::fill(counts.begin(), counts.end(), 0);
+            forSlices([&](size_t begin, size_t end, int)
+            {
+                for (size_t s = begin; s < end; s++)
+                {
+                    size_t* count = &counts[s * radix];
+                    for (size_t i = s * slice; i < std::min(n, (s + 1) * slice); i++)
+                        count[keys[i] >> shift & 0xFF]++;
+                }
+            });
+            // Digit major, slice minor, so equal digits keep their order
+            size_t offset = 0;
+            for (int d = 0; d < radix; d++)
+            {
+                for (int s = 0; s < slices; s++)
+                {
+                    size_t count = counts[size_t(s) * radix + d];
+                    counts[size_t(s) * radix + d] = offset;
+                    offset += count;
+                }
+            }
+            forSlices([&](size_t begin, size_t end, int)
+            {
+                for (size_t s = begin; s < end; s++)
+                {
+                    size_t* position = &counts[s * radix];
+                    for (size_t i = s * slice; i < std::min(n, (s + 1) * slice); i++)
+                    {
+                        size_t to = position[keys[i] >> shift & 0xFF]++;
+                        keyBuffer[to] = keys[i];
+                        valueBuffer[to] = values[i];
+                    }
+                }
+            });
+            keys.swap(keyBuffer);
+            values.swap(valueBuffer);
+        }
+    }
+
+}
\ No newline at end of file
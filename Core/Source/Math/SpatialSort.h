@@ -0,0 +1,84 @@
+// Spatially coherent orders of point sets
+#pragma once
+
+#include <vector>
+#include <span>
+#include <cstdint>
+#include <algorithm>
+#include <bit>
+
+#include "Point3D.h"
+#include "Core/ThreadPool.h"
+#include "Core/Profiler.h"
+
+namespace Core {
+
+    // Sorts 'keys' ascending and moves 'values' along, stable. LSD radix sort of 8 bits a pass,
+    // a pass whose digit is the same for every key is skipped. With a pool every worker counts
+    // and scatters its own slice of the keys.
+    void radixSort(std::vector<uint64_t>& keys, std::vector<uint32_t>& values, ThreadPool* pool = nullptr);
+
+    // Interleaves the low 21 bits of x, y and z, x in the lowest bit
+    uint64_t mortonKey(uint32_t x, uint32_t y, uint32_t z);
+
+    // Statelessly mixes a seed and an index into 64 random bits (splitmix64)
+    constexpr uint64_t mixBits(uint64_t seed, uint64_t index) {
+        uint64_t z = seed + (index + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /*
+    * Biased randomized insertion order (Amenta, Choi, Rote): every point joins the last round
+    * with probability 1/2, the one before with 1/4 and so on, and each round is sorted along a
+    * Morton curve of the bounding box. The rounds keep the expected work of a random order,
+    * the curve makes consecutive insertions touch nearby faces and points.
+    *
+    * 'order' receives a permutation of [0, points.size()), the same seed gives the same order.
+    *
+    * How to use:
+    * std::vector<uint32_t> order;
+    * brioOrder(std::span<const point3D<double>>(p), order, seed, &pool);
+    */
+    template<typename T>
+    void brioOrder(std::span<const point3D<T>> points, std::vector<uint32_t>& order, uint64_t seed, ThreadPool* pool = nullptr) {
+        CORE_PROFILE_FUNCTION();
+        constexpr int bits = 19;            // 3 * 19 Morton bits under 5 bits of round
+        constexpr int rounds = 32;
+        size_t n = points.size();
+        order.resize(n);
+        if (n == 0) {
+            return;
+        }
+        point3D<T> lo = points[0], hi = points[0];
+        for (const auto& q : points) {
+            lo = point3D<T>(std::min(lo.x, q.x), std::min(lo.y, q.y), std::min(lo.z, q.z));
+            hi = point3D<T>(std::max(hi.x, q.x), std::max(hi.y, q.y), std::max(hi.z, q.z));
+        }
+        // One cell size for all axes so the curve does not stretch along a flat box
+        double extent = std::max({ double(hi.x - lo.x), double(hi.y - lo.y), double(hi.z - lo.z) });
+        double cells = double((1u << bits) - 1);
+        double scale = extent > 0 ? cells / extent : 0;
+
+        std::vector<uint64_t> keys(n);
+        auto makeKeys = [&](size_t begin, size_t end, int) {
+            for (size_t i = begin; i < end; i++) {
+                const auto& q = points[i];
+                uint32_t x = uint32_t(std::min(double(q.x - lo.x) * scale, cells));
+                uint32_t y = uint32_t(std::min(double(q.y - lo.y) * scale, cells));
+                uint32_t z = uint32_t(std::min(double(q.z - lo.z) * scale, cells));
+                uint64_t level = std::min(std::countr_zero(mixBits(seed, i)), rounds - 1);
+                keys[i] = (uint64_t(rounds - 1) - level) << (3 * bits) | mortonKey(x, y, z);
+                order[i] = uint32_t(i);
+            }
+            };
+        if (pool) {
+            pool->parallelFor(n, 4096, makeKeys);
+        }
+        else {
+            makeKeys(0, n, 0);
+        }
+        radixSort(keys, order, pool);
+    }
+}
\ No newline at end of file
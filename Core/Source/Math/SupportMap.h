@@ -0,0 +1,472 @@
+// Support function queries over a hull and GJK/EPA between two hulls
+#pragma once
+
+#include <vector>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+
+#include "Point3D.h"
+#include "Pure3DHullAlgos.h"
+
+namespace Core {
+
+    /*
+    * Support function of a convex hull: the vertex farthest along a direction.
+    * Keeps the vertex adjacency of the hull in CSR form and hill climbs from the
+    * previous answer, so queries with slowly changing directions take a few steps.
+    *
+    * A vertex of a convex polytope with no neighbor farther along 'direction'
+    * is the farthest overall, so the climb never stops early.
+    *
+    * How to use:
+    * SupportMap<double> shape(points, ConvexHullMachine<double>::incrementalFast(points));
+    * auto far = shape.support(direction);
+    */
+    template<typename T>
+    class SupportMap {
+    public:
+        using point_t = point3D<T>;
+        using face_t = Tface<T>;
+
+        SupportMap(const std::vector<point_t>& points, const std::vector<face_t>& faces) {
+            // Hull vertices only, numbered in order of first use
+            std::vector<uint32_t> remap(points.size(), none);
+            for (const auto& f : faces) {
+                for (uint32_t v : { f.a, f.b, f.c }) {
+                    if (remap[v] == none) {
+                        remap[v] = uint32_t(m_vertices.size());
+                        m_vertices.push_back(points[v]);
+                    }
+                }
+            }
+
+            // Every directed edge appears once per face, its twin adds the other direction
+            std::vector<uint32_t> degree(m_vertices.size() + 1);
+            for (const auto& f : faces) {
+                degree[remap[f.a]]++;
+                degree[remap[f.b]]++;
+                degree[remap[f.c]]++;
+            }
+            m_offsets.assign(m_vertices.size() + 1, 0);
+            for (size_t i = 0; i < m_vertices.size(); i++) {
+                m_offsets[i + 1] = m_offsets[i] + degree[i];
+            }
+            m_neighbors.resize(m_offsets.back());
+            std::vector<uint32_t> fill(m_offsets.begin(), m_offsets.end() - 1);
+            for (const auto& f : faces) {
+                uint32_t a = remap[f.a], b = remap[f.b], c = remap[f.c];
+                m_neighbors[fill[a]++] = b;
+                m_neighbors[fill[b]++] = c;
+                m_neighbors[fill[c]++] = a;
+            }
+        }
+
+        // Index of the vertex farthest along 'direction', climbing from 'start'
+        uint32_t supportIndex(const point_t& direction, uint32_t start) const {
+            uint32_t current = start;
+            T best = dot(m_vertices[current], direction);
+            for (;;) {
+                uint32_t next = current;
+                for (uint32_t k = m_offsets[current]; k < m_offsets[current + 1]; k++) {
+                    uint32_t candidate = m_neighbors[k];
+                    T value = dot(m_vertices[candidate], direction);
+                    if (value > best) {
+                        best = value;
+                        next = candidate;
+                    }
+                }
+                if (next == current) {
+                    return current;
+                }
+                current = next;
+            }
+        }
+
+        // Warm started from the previous answer, one SupportMap per thread
+        const point_t& support(const point_t& direction) const {
+            m_last = supportIndex(direction, m_last);
+            return m_vertices[m_last];
+        }
+
+        const point_t& vertex(uint32_t i) const {
+            return m_vertices[i];
+        }
+
+        size_t vertexCount() const {
+            return m_vertices.size();
+        }
+
+        std::span<const uint32_t> neighbors(uint32_t i) const {
+            return { m_neighbors.data() + m_offsets[i], m_neighbors.data() + m_offsets[i + 1] };
+        }
+
+    private:
+        static constexpr uint32_t none = 0xFFFFFFFFu;
+
+        std::vector<point_t> m_vertices;
+        std::vector<uint32_t> m_offsets;
+        std::vector<uint32_t> m_neighbors;
+        mutable uint32_t m_last = 0;
+    };
+
+    template<typename T>
+    struct ContactResult {
+        bool intersecting = false;
+        // Separation distance, or penetration depth when intersecting
+        T distance = 0;
+        // Unit vector from A towards B. Moving B by -normal * distance makes separated shapes touch,
+        // moving it by normal * distance pushes intersecting ones apart
+        point3D<T> normal;
+        // Closest points when separated, deepest points when intersecting
+        point3D<T> pointA, pointB;
+        int iterations = 0;
+    };
+
+    /*
+    * GJK distance and EPA penetration between two hulls given in the same frame.
+    * Both walk the Minkowski difference A - B through the support maps,
+    * so they inherit their warm start.
+    */
+    template<typename T>
+    class Gjk {
+    public:
+        using point_t = point3D<T>;
+
+        static ContactResult<T> distance(const SupportMap<T>& a, const SupportMap<T>& b, int maxIterations = 64) {
+            Simplex simplex;
+            return run(a, b, simplex, maxIterations);
+        }
+
+        // GJK, then EPA when the hulls overlap
+        static ContactResult<T> penetration(const SupportMap<T>& a, const SupportMap<T>& b, int maxIterations = 128) {
+            Simplex simplex;
+            ContactResult<T> result = run(a, b, simplex, maxIterations);
+            if (result.intersecting) {
+                expand(a, b, simplex, result, maxIterations);
+            }
+            return result;
+        }
+
+    private:
+        static constexpr T tolerance = std::numeric_limits<T>::epsilon() * 128;
+
+        struct Vertex {
+            point_t w, a, b;    // w = a - b
+        };
+
+        struct Simplex {
+            Vertex v[4];
+            T lambda[4] = {};
+            int size = 0;
+
+            point_t closest() const {
+                point_t p;
+                for (int i = 0; i < size; i++) {
+                    p += v[i].w * lambda[i];
+                }
+                return p;
+            }
+        };
+
+        static Vertex minkowski(const SupportMap<T>& a, const SupportMap<T>& b, const point_t& direction) {
+            const point_t& pa = a.support(direction);
+            const point_t& pb = b.support(-direction);
+            return { pa - pb, pa, pb };
+        }
+
+        static ContactResult<T> run(const SupportMap<T>& a, const SupportMap<T>& b, Simplex& simplex, int maxIterations) {
+            ContactResult<T> result;
+            simplex.v[0] = minkowski(a, b, point_t(1, 0, 0));
+            simplex.lambda[0] = 1;
+            simplex.size = 1;
+            point_t v = simplex.v[0].w;
+            for (result.iterations = 0; result.iterations < maxIterations; result.iterations++) {
+                T v2 = norm(v);
+                if (v2 <= tolerance * tolerance * scale(simplex)) {
+                    result.intersecting = true;
+                    break;
+                }
+                Vertex w = minkowski(a, b, -v);
+                // No vertex gets closer than the current point: converged
+                if (v2 - dot(v, w.w) <= tolerance * v2 || contains(simplex, w.w)) {
+                    break;
+                }
+                simplex.v[simplex.size++] = w;
+                v = reduce(simplex);
+                if (simplex.size == 4) {
+                    result.intersecting = true;
+                    break;
+                }
+            }
+
+            point_t pa, pb;
+            for (int i = 0; i < simplex.size; i++) {
+                pa += simplex.v[i].a * simplex.lambda[i];
+                pb += simplex.v[i].b * simplex.lambda[i];
+            }
+            result.pointA = pa;
+            result.pointB = pb;
+            if (!result.intersecting) {
+                result.distance = abs(v);
+                result.normal = result.distance > 0 ? -v / result.distance : point_t();
+            }
+            return result;
+        }
+
+        static T scale(const Simplex& simplex) {
+            T s = 1;
+            for (int i = 0; i < simplex.size; i++) {
+                s = std::max(s, norm(simplex.v[i].w));
+            }
+            return s;
+        }
+
+        static bool contains(const Simplex& simplex, const point_t& w) {
+            for (int i = 0; i < simplex.size; i++) {
+                if (simplex.v[i].w == w) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Closest point of the simplex to the origin, drops the vertices it does not need
+        static point_t reduce(Simplex& s) {
+            switch (s.size) {
+            case 2: reduceSegment(s, 0, 1); break;
+            case 3: reduceTriangle(s, 0, 1, 2); break;
+            case 4: reduceTetrahedron(s); break;
+            }
+            return s.closest();
+        }
+
+        static void keep(Simplex& s, std::initializer_list<std::pair<int, T>> kept) {
+            Simplex r;
+            for (const auto& [i, lambda] : kept) {
+                r.v[r.size] = s.v[i];
+                r.lambda[r.size++] = lambda;
+            }
+            s = r;
+        }
+
+        static void reduceSegment(Simplex& s, int i, int j) {
+            const point_t& a = s.v[i].w;
+            point_t ab = s.v[j].w - a;
+            T length2 = norm(ab);
+            T t = length2 > 0 ? -dot(a, ab) / length2 : T(0);
+            if (t <= 0) {
+                keep(s, { { i, T(1) } });
+            }
+            else if (t >= 1) {
+                keep(s, { { j, T(1) } });
+            }
+            else {
+                keep(s, { { i, 1 - t }, { j, t } });
+            }
+        }
+
+        // Voronoi regions of the triangle, after Ericson's closest point on triangle
+        static void reduceTriangle(Simplex& s, int i, int j, int k) {
+            const point_t& a = s.v[i].w;
+            const point_t& b = s.v[j].w;
+            const point_t& c = s.v[k].w;
+            point_t ab = b - a, ac = c - a;
+            T d1 = -dot(ab, a), d2 = -dot(ac, a);
+            if (d1 <= 0 && d2 <= 0) {
+                return keep(s, { { i, T(1) } });
+            }
+            T d3 = -dot(ab, b), d4 = -dot(ac, b);
+            if (d3 >= 0 && d4 <= d3) {
+                return keep(s, { { j, T(1) } });
+            }
+            T vc = d1 * d4 - d3 * d2;
+            if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+                T t = d1 / (d1 - d3);
+                return keep(s, { { i, 1 - t }, { j, t } });
+            }
+            T d5 = -dot(ab, c), d6 = -dot(ac, c);
+            if (d6 >= 0 && d5 <= d6) {
+                return keep(s, { { k, T(1) } });
+            }
+            T vb = d5 * d2 - d1 * d6;
+            if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+                T t = d2 / (d2 - d6);
+                return keep(s, { { i, 1 - t }, { k, t } });
+            }
+            T va = d3 * d6 - d5 * d4;
+            if (va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) {
+                T t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+                return keep(s, { { j, 1 - t }, { k, t } });
+            }
+            T denominator = 1 / (va + vb + vc);
+            T v = vb * denominator, w = vc * denominator;
+            keep(s, { { i, 1 - v - w }, { j, v }, { k, w } });
+        }
+
+        static void reduceTetrahedron(Simplex& s) {
+            static constexpr int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 3, 1, 2 }, { 0, 2, 3, 1 }, { 1, 3, 2, 0 } };
+            const point_t origin;
+            bool outside = false;
+            Simplex best;
+            T bestDistance = std::numeric_limits<T>::max();
+            for (const auto& [i, j, k, l] : faces) {
+                const point_t& a = s.v[i].w;
+                // Origin and the fourth vertex on opposite sides of face ijk
+                T side = orient(a, s.v[j].w, s.v[k].w, origin);
+                T opposite = orient(a, s.v[j].w, s.v[k].w, s.v[l].w);
+                if (side * opposite > 0) {
+                    continue;
+                }
+                outside = true;
+                Simplex candidate = s;
+                reduceTriangle(candidate, i, j, k);
+                T distance = norm(candidate.closest());
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = candidate;
+                }
+            }
+            if (outside) {
+                s = best;
+            }
+            // Otherwise the origin is inside, the tetrahedron stays for EPA
+        }
+
+        struct Face {
+            int a, b, c;
+            point_t n;      // unit, pointing away from the origin
+            T d;            // distance of the plane from the origin
+        };
+
+        // Builds a tetrahedron around the origin out of whatever GJK stopped with
+        static bool blowUp(const SupportMap<T>& a, const SupportMap<T>& b, Simplex& s) {
+            static const point_t axes[6] = {
+                point_t(1, 0, 0), point_t(-1, 0, 0), point_t(0, 1, 0),
+                point_t(0, -1, 0), point_t(0, 0, 1), point_t(0, 0, -1)
+            };
+            auto tryAdd = [&](const point_t& direction) {
+                Vertex w = minkowski(a, b, direction);
+                if (contains(s, w.w)) {
+                    return false;
+                }
+                s.v[s.size++] = w;
+                return true;
+                };
+            for (int i = 0; s.size == 1 && i < 6; i++) {
+                tryAdd(axes[i]);
+            }
+            if (s.size == 2) {
+                point_t d = s.v[1].w - s.v[0].w;
+                // Axis least aligned with the segment
+                point_t axis = std::abs(d.x) < std::abs(d.y) && std::abs(d.x) < std::abs(d.z) ? axes[0]
+                    : std::abs(d.y) < std::abs(d.z) ? axes[2] : axes[4];
+                point_t perpendicular = cross(d, axis);
+                if (!tryAdd(perpendicular)) {
+                    tryAdd(-perpendicular);
+                }
+            }
+            if (s.size == 3) {
+                point_t n = normalVector(s.v[0].w, s.v[1].w, s.v[2].w);
+                if (!tryAdd(n)) {
+                    tryAdd(-n);
+                }
+            }
+            if (s.size < 4) {
+                return false;
+            }
+            T volume = orient(s.v[0].w, s.v[1].w, s.v[2].w, s.v[3].w);
+            if (volume == 0) {
+                return false;
+            }
+            if (volume < 0) {
+                std::swap(s.v[1], s.v[2]);
+            }
+            return true;
+        }
+
+        static void expand(const SupportMap<T>& a, const SupportMap<T>& b, Simplex& simplex, ContactResult<T>& result, int maxIterations) {
+            result.distance = 0;
+            result.normal = point_t();
+            if (!blowUp(a, b, simplex)) {
+                // Touching, the Minkowski difference has no volume around the origin
+                return;
+            }
+            std::vector<Vertex> vertices(simplex.v, simplex.v + 4);
+            std::vector<Face> faces;
+            auto addFace = [&](int i, int j, int k) {
+                point_t n = normalVector(vertices[i].w, vertices[j].w, vertices[k].w);
+                T length = abs(n);
+                if (length <= 0) {
+                    return;
+                }
+                n /= length;
+                faces.push_back({ i, j, k, n, dot(n, vertices[i].w) });
+                };
+            // Positive orientation: 0, 1, 2 is clockwise seen from 3
+            addFace(0, 2, 1);
+            addFace(0, 1, 3);
+            addFace(1, 2, 3);
+            addFace(2, 0, 3);
+
+            // Out of iterations the closest face so far is still a lower bound of the depth
+            Face face = {};
+            bool found = false;
+            for (int iteration = 0; iteration < maxIterations && !faces.empty(); iteration++) {
+                face = *std::min_element(faces.begin(), faces.end(), [](const Face& lhs, const Face& rhs) {
+                    return lhs.d < rhs.d;
+                    });
+                found = true;
+                Vertex w = minkowski(a, b, face.n);
+                result.iterations++;
+                if (dot(face.n, w.w) - face.d <= tolerance * std::max(T(1), std::abs(face.d))) {
+                    break;
+                }
+                int index = int(vertices.size());
+                vertices.push_back(w);
+                // Remove the faces the new vertex sees and close the hole from the horizon
+                std::vector<std::pair<int, int>> horizon;
+                auto toggle = [&](int i, int j) {
+                    auto twin = std::find(horizon.begin(), horizon.end(), std::make_pair(j, i));
+                    if (twin != horizon.end()) {
+                        horizon.erase(twin);
+                    }
+                    else {
+                        horizon.emplace_back(i, j);
+                    }
+                    };
+                faces.erase(std::remove_if(faces.begin(), faces.end(), [&](const Face& f) {
+                    if (dot(f.n, w.w - vertices[f.a].w) <= 0) {
+                        return false;
+                    }
+                    toggle(f.a, f.b);
+                    toggle(f.b, f.c);
+                    toggle(f.c, f.a);
+                    return true;
+                    }), faces.end());
+                for (const auto& [i, j] : horizon) {
+                    addFace(i, j, index);
+                }
+            }
+            if (!found) {
+                return;
+            }
+
+            // Project the origin on the face, the same weights give the points on A and B
+            point_t p = face.n * face.d;
+            const point_t& va = vertices[face.a].w;
+            point_t v0 = vertices[face.b].w - va, v1 = vertices[face.c].w - va, v2 = p - va;
+            T d00 = dot(v0, v0), d01 = dot(v0, v1), d11 = dot(v1, v1);
+            T d20 = dot(v2, v0), d21 = dot(v2, v1);
+            T denominator = d00 * d11 - d01 * d01;
+            T u = denominator != 0 ? (d11 * d20 - d01 * d21) / denominator : T(0);
+            T v = denominator != 0 ? (d00 * d21 - d01 * d20) / denominator : T(0);
+            T t = 1 - u - v;
+            result.pointA = vertices[face.a].a * t + vertices[face.b].a * u + vertices[face.c].a * v;
+            result.pointB = vertices[face.a].b * t + vertices[face.b].b * u + vertices[face.c].b * v;
+            result.distance = face.d;
+            result.normal = face.n;
+        }
+    };
+}
\ No newline at end of file
@@ -2,6 +2,13 @@
 
 namespace Core {
 
+	void BufferLayout::push(const BufferElement& element)
+	{
+		assert((not BufferElement::isPacked(element.type) || element.count == 4) && "packed formats have 4 components");
+		m_BufferElements.push_back(element);
+		m_stride += (unsigned int)element.getSize();
+	}
+
 	void BufferLayout::pushFloat(int count)
 	{
 		m_BufferElements.emplace_back(count, GL_FLOAT, GL_FALSE);
@@ -9,13 +16,14 @@ namespace Core {
 	}
 
 
-	IndexBuffer::IndexBuffer(const unsigned int* data, int count) : m_count(count) {
+	IndexBuffer::IndexBuffer(const unsigned int* data, int count) : m_count(count), m_capacity(count) {
 		glGenBuffers(1, &m_rendererId);
 		// From TheCherno
 		// GL_ELEMENT_ARRAY_BUFFER is not valid without an actively bound VAO
 		// Binding with GL_ARRAY_BUFFER allows the data to be loaded regardless of VAO state. 
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererId);
 		glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_STATIC_DRAW);
+		BufferStats::record(count * sizeof(unsigned int));
 	}
 
 	IndexBuffer::~IndexBuffer()
@@ -33,6 +41,20 @@ namespace Core {
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
+	void IndexBuffer::setBuffer(const unsigned int* data, int count)
+	{
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererId);
+		if (count > m_capacity)
+		{
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, count * sizeof(unsigned int), data, GL_DYNAMIC_DRAW);
+			m_capacity = count;
+		}
+		else
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, count * sizeof(unsigned int), data);
+		m_count = count;
+		BufferStats::record(count * sizeof(unsigned int));
+	}
+
 	IndexBuffer* IndexBuffer::create(const unsigned int* data, int count)
 	{
 		return new IndexBuffer(data, count);
@@ -60,6 +82,20 @@ namespace Core {
 		glBindBuffer(GL_ARRAY_BUFFER, m_rendererId);
 		// may cause GL_INVALID_VALUE (501) if size > current buffer size
 		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		BufferStats::record(size);
+	}
+
+	void* VertexBuffer::map()
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_rendererId);
+		return glMapBufferRange(GL_ARRAY_BUFFER, 0, m_size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	}
+
+	void VertexBuffer::unmap()
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, m_rendererId);
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		BufferStats::record(m_size);
 	}
 
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include <glad/glad.h>
 #include <vector>
 #include <cassert>
+#include <cstdint>
+#include <initializer_list>
 
 namespace Core {
 
@@ -12,9 +14,39 @@ namespace Core {
 		GLboolean normalized;
 
 		static size_t sizeOfType(GLenum type) {
-			assert(type == GL_FLOAT && "only support for GL_FLOAT");
-			return sizeof(float);
+			switch (type)
+			{
+			case GL_FLOAT: return sizeof(float);
+			case GL_HALF_FLOAT: return sizeof(uint16_t);
+			case GL_SHORT:
+			case GL_UNSIGNED_SHORT: return sizeof(int16_t);
+			case GL_BYTE:
+			case GL_UNSIGNED_BYTE: return sizeof(int8_t);
+			// Packed formats hold all four components in one 32-bit word
+			case GL_INT_2_10_10_10_REV:
+			case GL_UNSIGNED_INT_2_10_10_10_REV: return sizeof(uint32_t);
+			}
+			assert(false && "unsupported vertex attribute type");
+			return 0;
 		}
+
+		static bool isPacked(GLenum type) {
+			return type == GL_INT_2_10_10_10_REV || type == GL_UNSIGNED_INT_2_10_10_10_REV;
+		}
+
+		size_t getSize() const {
+			return isPacked(type) ? sizeOfType(type) : count * sizeOfType(type);
+		}
+	};
+
+	// Upload counters, read and reset once per frame by the performance panel
+	struct BufferStats
+	{
+		static inline uint64_t uploads = 0;
+		static inline uint64_t bytes = 0;
+
+		static void record(size_t size) { uploads++; bytes += size; }
+		static void reset() { uploads = bytes = 0; }
 	};
 
 	class BufferLayout
@@ -26,12 +58,20 @@ namespace Core {
 		{
 			pushFloat(count, std::forward<T>(args)...);
 		}
+		// For non float attributes, e.g. { { 4, GL_SHORT, GL_TRUE } }
+		BufferLayout(std::initializer_list<BufferElement> elements)
+			: m_stride()
+		{
+			for (const BufferElement& element : elements)
+				push(element);
+		}
 
 		std::vector<BufferElement>::const_iterator begin() const { return m_BufferElements.begin(); }
 		std::vector<BufferElement>::const_iterator end() const { return m_BufferElements.end(); }
 		unsigned int getStride() const { return m_stride; }
 
 	private:
+		void push(const BufferElement& element);
 		void pushFloat(int count);
 		template<typename... T>
 		void pushFloat(int head, T&&... rest) {
@@ -54,6 +94,10 @@ namespace Core {
 		void bind() const;
 		void unbind() const;
 
+		// Replaces the contents in place, the store only grows when count passes the largest one so far.
+		// Binds the buffer, so the vertex array that should keep it must be bound
+		void setBuffer(const unsigned int* data, int count);
+
 		int getCount() const { return m_count; }
 
 		static IndexBuffer* create(const unsigned int* data, int count);
@@ -61,6 +105,7 @@ namespace Core {
 	private:
 		unsigned int m_rendererId;
 		int m_count;
+		int m_capacity;
 	};
 
 
@@ -70,26 +115,31 @@ namespace Core {
 		// dynamic draw
 		template<typename... T>
 		explicit VertexBuffer(size_t size, T&&... layout_args)
-			: m_layout(std::forward<T>(layout_args)...)
+			: m_layout(std::forward<T>(layout_args)...), m_size(size)
 		{
 			glGenBuffers(1, &m_rendererId);
 			glBindBuffer(GL_ARRAY_BUFFER, m_rendererId);
 			glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
 		}
-		// static draw
+		// static draw, pass nullptr as data to fill it later through map()
 		template<typename... T>
 		explicit VertexBuffer(const void* data, size_t size, T&&... layout_args)
-			: m_layout(std::forward<T>(layout_args)...)
+			: m_layout(std::forward<T>(layout_args)...), m_size(size)
 		{
 			glGenBuffers(1, &m_rendererId);
 			glBindBuffer(GL_ARRAY_BUFFER, m_rendererId);
 			glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+			if (data != nullptr)
+				BufferStats::record(size);
 		}
 		~VertexBuffer();
 
 		void bind() const;
 		void unbind() const;
 		void setBuffer(const void* data, size_t size);
+		// Write access to the whole store, previous contents are discarded
+		void* map();
+		void unmap();
 
 		const BufferLayout& getLayout() const { return m_layout; }
 		void setLayout(const BufferLayout& layout) { m_layout = layout; }
@@ -102,6 +152,7 @@ namespace Core {
 	private:
 		unsigned int m_rendererId;
 		BufferLayout m_layout;
+		size_t m_size;
 	};
 
 }
\ No newline at end of file
@@ -32,6 +32,7 @@ namespace Core {
 		void setPosition(const glm::vec3& newPosition) { m_cameraPos = newPosition; }
 		void setZNear(float zNear) { m_zNear = zNear; }
 		void setZFar(float zFar) { m_zFar = zFar; }
+		void setAspect(float aspect) { m_aspect = aspect; }
 	private:
 		static constexpr glm::vec3 s_cameraUp = glm::vec3(0.0f, 1.0f, 0.0f);
 		glm::vec3 m_cameraPos;
@@ -0,0 +1,92 @@
+#include "Framebuffer.h"
+#include <cassert>
+#include <cstring>
+
+namespace Core {
+
+	Framebuffer::Framebuffer(int width, int height, int samples)
+		: m_width(width), m_height(height), m_samples(samples)
+	{
+		m_rendererId = createTarget(width, height, samples, &m_color, &m_depth);
+		if (samples > 0)
+			m_resolveId = createTarget(width, height, 0, &m_resolveColor, nullptr);
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	Framebuffer::~Framebuffer()
+	{
+		unsigned int framebuffers[] = { m_rendererId, m_resolveId };
+		unsigned int renderbuffers[] = { m_color, m_depth, m_resolveColor };
+		glDeleteFramebuffers(2, framebuffers);
+		glDeleteRenderbuffers(3, renderbuffers);
+	}
+
+	unsigned int Framebuffer::createTarget(int width, int height, int samples, unsigned int* color, unsigned int* depth)
+	{
+		unsigned int id;
+		glGenFramebuffers(1, &id);
+		glBindFramebuffer(GL_FRAMEBUFFER, id);
+
+		glGenRenderbuffers(1, color);
+		glBindRenderbuffer(GL_RENDERBUFFER, *color);
+		glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, width, height);
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, *color);
+
+		if (depth)
+		{
+			glGenRenderbuffers(1, depth);
+			glBindRenderbuffer(GL_RENDERBUFFER, *depth);
+			glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH_COMPONENT24, width, height);
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, *depth);
+		}
+		assert(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE && "Framebuffer is incomplete!");
+		return id;
+	}
+
+	void Framebuffer::bind() const
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, m_rendererId);
+		glViewport(0, 0, m_width, m_height);
+	}
+
+	void Framebuffer::unbind() const
+	{
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	std::vector<uint8_t> Framebuffer::readPixels() const
+	{
+		unsigned int source = m_rendererId;
+		if (m_resolveId)
+		{
+			glBindFramebuffer(GL_READ_FRAMEBUFFER, m_rendererId);
+			glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_resolveId);
+			glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+			source = m_resolveId;
+		}
+		size_t stride = size_t(m_width) * 4;
+		std::vector<uint8_t> pixels(stride * m_height);
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, source);
+		glPixelStorei(GL_PACK_ALIGNMENT, 1);
+		glReadPixels(0, 0, m_width, m_height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		// GL rows start at the bottom
+		std::vector<uint8_t> row(stride);
+		for (int y = 0; y < m_height / 2; y++)
+		{
+			uint8_t* top = pixels.data() + y * stride;
+			uint8_t* bottom = pixels.data() + (m_height - 1 - y) * stride;
+			std::memcpy(row.data(), top, stride);
+			std::memcpy(top, bottom, stride);
+			std::memcpy(bottom, row.data(), stride);
+		}
+		return pixels;
+	}
+
+	Framebuffer* Framebuffer::create(int width, int height, int samples)
+	{
+		return new Framebuffer(width, height, samples);
+	}
+
+}
\ No newline at end of file
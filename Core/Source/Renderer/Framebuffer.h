@@ -0,0 +1,44 @@
+#pragma once
+#include <glad/glad.h>
+#include <vector>
+#include <cstdint>
+
+namespace Core {
+
+	// Offscreen render target: RGBA8 color and 24-bit depth, multisampled when samples > 0.
+	// readPixels() resolves into a single-sampled target first.
+	class Framebuffer
+	{
+	public:
+		Framebuffer(int width, int height, int samples = 0);
+		~Framebuffer();
+
+		void bind() const;
+		void unbind() const;
+
+		// Tightly packed RGBA rows, top row first
+		std::vector<uint8_t> readPixels() const;
+
+		int getWidth() const { return m_width; }
+		int getHeight() const { return m_height; }
+		int getSamples() const { return m_samples; }
+
+		static Framebuffer* create(int width, int height, int samples = 0);
+
+	private:
+		// Depth is skipped when depth == nullptr
+		static unsigned int createTarget(int width, int height, int samples, unsigned int* color, unsigned int* depth);
+
+	private:
+		unsigned int m_rendererId = 0;
+		unsigned int m_color = 0;
+		unsigned int m_depth = 0;
+		// Single-sampled copy for readPixels, only with samples > 0
+		unsigned int m_resolveId = 0;
+		unsigned int m_resolveColor = 0;
+		int m_width;
+		int m_height;
+		int m_samples;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "GpuTimer.h"
+#include <cassert>
+
+namespace Core {
+
+	GpuTimer::~GpuTimer()
+	{
+		for (auto& frame : m_frames)
+		{
+			for (const Query& query : frame)
+				glDeleteQueries(1, &query.id);
+		}
+		if (not m_freeQueries.empty())
+			glDeleteQueries((GLsizei)m_freeQueries.size(), m_freeQueries.data());
+	}
+
+	void GpuTimer::beginFrame()
+	{
+		assert(not m_active && "GpuTimer frame started inside a timed pass");
+		m_frame = (m_frame + 1) % s_latency;
+		std::vector<Query>& oldest = m_frames[m_frame];
+		if (oldest.empty())
+			return;
+
+		uint64_t elapsed[(int)GpuPass::Count] = {};
+		int draws[(int)GpuPass::Count] = {};
+		bool complete = true;
+		for (const Query& query : oldest)
+		{
+			int available = 0;
+			glGetQueryObjectiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available)
+			{
+				GLuint64 ns = 0;
+				glGetQueryObjectui64v(query.id, GL_QUERY_RESULT, &ns);
+				elapsed[(int)query.pass] += ns;
+				draws[(int)query.pass]++;
+			}
+			else
+			{
+				// Too late, drop this frame rather than stall
+				complete = false;
+			}
+			m_freeQueries.push_back(query.id);
+		}
+		oldest.clear();
+		if (not complete)
+			return;
+		for (int pass = 0; pass < (int)GpuPass::Count; pass++)
+		{
+			m_passTime[pass] = elapsed[pass] / 1e6;
+			m_drawCount[pass] = draws[pass];
+		}
+	}
+
+	void GpuTimer::begin(GpuPass pass)
+	{
+		assert(not m_active && "GL_TIME_ELAPSED queries cannot nest");
+		unsigned int id;
+		if (m_freeQueries.empty())
+		{
+			glGenQueries(1, &id);
+		}
+		else
+		{
+			id = m_freeQueries.back();
+			m_freeQueries.pop_back();
+		}
+		m_frames[m_frame].push_back({ id, pass });
+		glBeginQuery(GL_TIME_ELAPSED, id);
+		m_active = true;
+	}
+
+	void GpuTimer::end()
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_active = false;
+	}
+
+}
\ No newline at end of file
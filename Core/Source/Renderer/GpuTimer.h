@@ -0,0 +1,58 @@
+#pragma once
+#include <glad/glad.h>
+#include <vector>
+#include <cstdint>
+
+namespace Core {
+
+	enum class GpuPass
+	{
+		Points, Lines, Triangles, Count
+	};
+
+	// GL_TIME_ELAPSED queries around draw calls, summed per pass and per frame.
+	// Results are read s_latency frames later so the CPU never waits on the GPU.
+	class GpuTimer
+	{
+	public:
+		static constexpr int s_latency = 4;
+
+		GpuTimer() = default;
+		~GpuTimer();
+
+		// Collects the oldest frame in flight and starts recording a new one
+		void beginFrame();
+		void begin(GpuPass pass);
+		void end();
+
+		// Milliseconds spent in `pass` by the last collected frame
+		double getPassTime(GpuPass pass) const { return m_passTime[(int)pass]; }
+		int getDrawCount(GpuPass pass) const { return m_drawCount[(int)pass]; }
+
+	private:
+		struct Query
+		{
+			unsigned int id;
+			GpuPass pass;
+		};
+
+	private:
+		std::vector<Query> m_frames[s_latency];
+		std::vector<unsigned int> m_freeQueries;
+		int m_frame = 0;
+		bool m_active = false;
+		double m_passTime[(int)GpuPass::Count] = {};
+		int m_drawCount[(int)GpuPass::Count] = {};
+	};
+
+	class GpuTimerScope
+	{
+	public:
+		GpuTimerScope(GpuTimer& timer, GpuPass pass) : m_timer(timer) { m_timer.begin(pass); }
+		~GpuTimerScope() { m_timer.end(); }
+
+	private:
+		GpuTimer& m_timer;
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+#include "PngWriter.h"
+#include <fstream>
+#include <algorithm>
+#include <cassert>
+
+namespace Core {
+
+	namespace {
+
+		constexpr int s_windowSize = 1 << 15;
+		constexpr int s_hashBits = 15;
+		constexpr int s_maxChain = 32;
+		constexpr int s_minMatch = 3;
+		constexpr int s_maxMatch = 258;
+
+		constexpr uint16_t s_lengthBase[] = {
+			3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+			35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+		};
+		constexpr uint8_t s_lengthExtra[] = {
+			0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+			3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+		};
+		constexpr uint16_t s_distanceBase[] = {
+			1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+			257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+		};
+		constexpr uint8_t s_distanceExtra[] = {
+			0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+			7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+		};
+
+		// Deflate packs bits from the least significant end, Huffman codes from their top bit
+		class BitWriter
+		{
+		public:
+			BitWriter(std::vector<uint8_t>& out) : m_out(out) {}
+
+			void put(uint32_t bits, int count)
+			{
+				m_buffer |= bits << m_count;
+				m_count += count;
+				while (m_count >= 8)
+				{
+					m_out.push_back(uint8_t(m_buffer));
+					m_buffer >>= 8;
+					m_count -= 8;
+				}
+			}
+
+			void putCode(uint32_t code, int length)
+			{
+				uint32_t reversed = 0;
+				for (int i = 0; i < length; i++)
+					reversed |= ((code >> i) & 1u) << (length - 1 - i);
+				put(reversed, length);
+			}
+
+			void flush()
+			{
+				if (m_count > 0)
+					m_out.push_back(uint8_t(m_buffer));
+				m_buffer = 0;
+				m_count = 0;
+			}
+
+		private:
+			std::vector<uint8_t>& m_out;
+			uint32_t m_buffer = 0;
+			int m_count = 0;
+		};
+
+		void putLiteral(BitWriter& writer, int symbol)
+		{
+			if (symbol < 144)
+				writer.putCode(0x30 + symbol, 8);
+			else if (symbol < 256)
+				writer.putCode(0x190 + symbol - 144, 9);
+			else if (symbol < 280)
+				writer.putCode(symbol - 256, 7);
+			else
+				writer.putCode(0xC0 + symbol - 280, 8);
+		}
+
+		void putMatch(BitWriter& writer, int length, int distance)
+		{
+			int code = 28;
+			while (s_lengthBase[code] > length)
+				code--;
+			putLiteral(writer, 257 + code);
+			writer.put(length - s_lengthBase[code], s_lengthExtra[code]);
+
+			code = 29;
+			while (s_distanceBase[code] > distance)
+				code--;
+			writer.putCode(code, 5);
+			writer.put(distance - s_distanceBase[code], s_distanceExtra[code]);
+		}
+
+		uint32_t hash3(const uint8_t* p)
+		{
+			uint32_t v = uint32_t(p[0]) | uint32_t(p[1]) << 8 | uint32_t(p[2]) << 16;
+			return (v * 2654435761u) >> (32 - s_hashBits);
+		}
+
+		// zlib stream holding one fixed Huffman block
+		std::vector<uint8_t> compress(const std::vector<uint8_t>& data)
+		{
+			std::vector<uint8_t> out = { 0x78, 0x01 };
+			BitWriter writer(out);
+			writer.put(1, 1);   // final block
+			writer.put(1, 2);   // fixed Huffman
+
+			const int size = (int)data.size();
+			std::vector<int> head(size_t(1) << s_hashBits, -1);
+			std::vector<int> prev(s_windowSize, -1);
+			auto insert = [&](int pos)
+			{
+				if (pos + s_minMatch > size)
+					return;
+				uint32_t h = hash3(&data[pos]);
+				prev[pos & (s_windowSize - 1)] = head[h];
+				head[h] = pos;
+			};
+
+			int pos = 0;
+			while (pos < size)
+			{
+				int bestLength = 0;
+				int bestDistance = 0;
+				if (pos + s_minMatch <= size)
+				{
+					int limit = std::min(s_maxMatch, size - pos);
+					int candidate = head[hash3(&data[pos])];
+					for (int chain = 0; chain < s_maxChain && candidate >= 0 && pos - candidate <= s_windowSize - 1; chain++)
+					{
+						int length = 0;
+						while (length < limit && data[candidate + length] == data[pos + length])
+							length++;
+						if (length > bestLength)
+						{
+							bestLength = length;
+							bestDistance = pos - candidate;
+							if (length == limit)
+								break;
+						}
+						candidate = prev[candidate & (s_windowSize - 1)];
+					}
+				}
+				if (bestLength >= s_minMatch)
+				{
+					putMatch(writer, bestLength, bestDistance);
+					for (int i = 0; i < bestLength; i++)
+						insert(pos + i);
+					pos += bestLength;
+				}
+				else
+				{
+					putLiteral(writer, data[pos]);
+					insert(pos);
+					pos++;
+				}
+			}
+			putLiteral(writer, 256);
+			writer.flush();
+
+			uint32_t a = 1, b = 0;
+			for (uint8_t byte : data)
+			{
+				a = (a + byte) % 65521;
+				b = (b + a) % 65521;
+			}
+			uint32_t adler = b << 16 | a;
+			for (int shift = 24; shift >= 0; shift -= 8)
+				out.push_back(uint8_t(adler >> shift));
+			return out;
+		}
+
+		uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0)
+		{
+			static const auto table = []()
+			{
+				std::vector<uint32_t> t(256);
+				for (uint32_t n = 0; n < 256; n++)
+				{
+					uint32_t c = n;
+					for (int k = 0; k < 8; k++)
+						c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+					t[n] = c;
+				}
+				return t;
+			}();
+			crc = ~crc;
+			for (size_t i = 0; i < size; i++)
+				crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+			return ~crc;
+		}
+
+		void putChunk(std::vector<uint8_t>& png, const char type[4], const std::vector<uint8_t>& data)
+		{
+			uint32_t length = (uint32_t)data.size();
+			for (int shift = 24; shift >= 0; shift -= 8)
+				png.push_back(uint8_t(length >> shift));
+			size_t start = png.size();
+			png.insert(png.end(), type, type + 4);
+			png.insert(png.end(), data.begin(), data.end());
+			uint32_t crc = crc32(&png[start], png.size() - start);
+			for (int shift = 24; shift >= 0; shift -= 8)
+				png.push_back(uint8_t(crc >> shift));
+		}
+	}
+
+	std::vector<uint8_t> encodePng(int width, int height, int channels, const uint8_t* pixels)
+	{
+		assert(channels >= 1 && channels <= 4 && "PNG supports 1 to 4 channels");
+		constexpr uint8_t colorTypes[] = { 0, 0, 4, 2, 6 };
+		size_t stride = size_t(width) * channels;
+
+		std::vector<uint8_t> filtered;
+		filtered.reserve((stride + 1) * height);
+		for (int y = 0; y < height; y++)
+		{
+			const uint8_t* row = pixels + y * stride;
+			filtered.push_back(1);  // Sub
+			for (size_t x = 0; x < stride; x++)
+				filtered.push_back(uint8_t(row[x] - (x >= size_t(channels) ? row[x - channels] : 0)));
+		}
+
+		std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+		std::vector<uint8_t> header;
+		for (uint32_t value : { uint32_t(width), uint32_t(height) })
+		{
+			for (int shift = 24; shift >= 0; shift -= 8)
+				header.push_back(uint8_t(value >> shift));
+		}
+		header.insert(header.end(), { 8, colorTypes[channels], 0, 0, 0 });
+		putChunk(png, "IHDR", header);
+		putChunk(png, "IDAT", compress(filtered));
+		putChunk(png, "IEND", {});
+		return png;
+	}
+
+	bool writePng(const std::string& path, int width, int height, int channels, const uint8_t* pixels)
+	{
+		std::vector<uint8_t> png = encodePng(width, height, channels, pixels);
+		std::ofstream file(path, std::ios::binary);
+		if (not file)
+			return false;
+		file.write((const char*)png.data(), png.size());
+		return bool(file);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,14 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace Core {
+
+	// Minimal PNG encoder for snapshots: 8-bit gray/gray-alpha/RGB/RGBA rows, top row first.
+	// Rows use the Sub filter and a greedy LZ77 with fixed Huffman codes, which keeps
+	// flat rendered backgrounds small without a zlib dependency.
+	std::vector<uint8_t> encodePng(int width, int height, int channels, const uint8_t* pixels);
+	bool writePng(const std::string& path, int width, int height, int channels, const uint8_t* pixels);
+
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "PointCloudLOD.h"
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+
+namespace Core {
+
+	namespace {
+		// Spreads the low 10 bits so two zero bits separate each of them
+		uint32_t expandBits(uint32_t v)
+		{
+			v = (v * 0x00010001u) & 0xFF0000FFu;
+			v = (v * 0x00000101u) & 0x0F00F00Fu;
+			v = (v * 0x00000011u) & 0xC30C30C3u;
+			v = (v * 0x00000005u) & 0x49249249u;
+			return v;
+		}
+
+		uint32_t mortonCode(const glm::vec3& normalized)
+		{
+			glm::vec3 cell = glm::clamp((normalized + 1.0f) * 512.0f, 0.0f, 1023.0f);
+			return (expandBits((uint32_t)cell.x) << 2) | (expandBits((uint32_t)cell.y) << 1) | expandBits((uint32_t)cell.z);
+		}
+
+		uint32_t reverseBits(uint32_t v, int bits)
+		{
+			uint32_t result = 0;
+			for (int i = 0; i < bits; i++, v >>= 1)
+				result = (result << 1) | (v & 1u);
+			return result;
+		}
+	}
+
+	PointCloudLOD::PointCloudLOD(const glm::vec3* points, size_t count, const QuantizationBounds& bounds,
+								 VertexFormat format, int chunkSize)
+	{
+		std::vector<std::pair<uint32_t, unsigned int>> keys(count);
+		for (size_t i = 0; i < count; i++)
+			keys[i] = { mortonCode(bounds.quantize(points[i])), (unsigned int)i };
+		std::sort(keys.begin(), keys.end());
+
+		m_order.resize(count);
+		m_slot.resize(count);
+		int bits = 0;
+		while ((1 << bits) < chunkSize)
+			bits++;
+		for (size_t first = 0; first < count; first += chunkSize)
+		{
+			int size = (int)std::min<size_t>(chunkSize, count - first);
+			// Bit-reversed positions of a Morton run give a stratified prefix
+			int slot = (int)first;
+			for (uint32_t k = 0; k < (1u << bits); k++)
+			{
+				uint32_t position = reverseBits(k, bits);
+				if ((int)position < size)
+					m_order[slot++] = keys[first + position].second;
+			}
+
+			Chunk chunk{ glm::vec3(0.0f), 0.0f, (int)first, size };
+			glm::vec3 lo = points[m_order[first]], hi = lo;
+			for (int i = 0; i < size; i++)
+			{
+				lo = glm::min(lo, points[m_order[first + i]]);
+				hi = glm::max(hi, points[m_order[first + i]]);
+			}
+			chunk.center = 0.5f * (lo + hi);
+			chunk.radius = 0.5f * glm::length(hi - lo);
+			m_chunks.push_back(chunk);
+		}
+		for (size_t i = 0; i < count; i++)
+			m_slot[m_order[i]] = (unsigned int)i;
+
+		size_t vertexSize = getVertexSize(format);
+		auto vertexBuffer = createRef<VertexBuffer>(
+			nullptr,
+			vertexSize * count,
+			BufferLayout{ getPositionElement(format) }  // position
+		);
+		unsigned char* data = static_cast<unsigned char*>(vertexBuffer->map());
+		for (size_t i = 0; i < count; i++)
+			quantizePositions(format, &points[m_order[i]], 1, bounds, data + i * vertexSize);
+		vertexBuffer->unmap();
+
+		m_vertexArray.reset(VertexArray::create());
+		m_vertexArray->setVertexBuffer(vertexBuffer);
+		m_vertexArray->setIndexBuffer(createRef<IndexBuffer>(nullptr, 0));
+		m_drawFirst.reserve(m_chunks.size());
+		m_drawCount.reserve(m_chunks.size());
+	}
+
+	void PointCloudLOD::setPinnedPoints(const unsigned int* indices, int count)
+	{
+		m_pinned.resize(count);
+		for (int i = 0; i < count; i++)
+			m_pinned[i] = m_slot[indices[i]];
+		m_vertexArray->bind();
+		m_vertexArray->getIndexBuffer()->setBuffer(m_pinned.data(), count);
+	}
+
+	void PointCloudLOD::update(const glm::mat4& pointToClip, float projectionScale, float maxScreenError)
+	{
+		// Frustum planes straight from the matrix rows (Gribb/Hartmann)
+		glm::mat4 m = glm::transpose(pointToClip);
+		glm::vec4 planes[6] = { m[3] + m[0], m[3] - m[0], m[3] + m[1], m[3] - m[1], m[3] + m[2], m[3] - m[2] };
+		for (glm::vec4& plane : planes)
+			plane /= glm::length(glm::vec3(plane));
+
+		m_drawFirst.clear();
+		m_drawCount.clear();
+		m_drawnCount = 0;
+		for (const Chunk& chunk : m_chunks)
+		{
+			bool visible = true;
+			for (const glm::vec4& plane : planes)
+				visible = visible && glm::dot(glm::vec3(plane), chunk.center) + plane.w >= -chunk.radius;
+			if (not visible)
+				continue;
+
+			float w = (pointToClip * glm::vec4(chunk.center, 1.0f)).w;
+			int count = chunk.count;
+			if (w > chunk.radius)
+			{
+				// n stratified points over a disc of diameter D pixels leave gaps of about D / sqrt(n)
+				float diameter = 2.0f * chunk.radius * projectionScale / w;
+				float needed = std::ceil((diameter / maxScreenError) * (diameter / maxScreenError));
+				count = (int)std::clamp(needed, 1.0f, (float)chunk.count);
+			}
+			m_drawFirst.push_back(chunk.first);
+			m_drawCount.push_back(count);
+			m_drawnCount += count;
+		}
+	}
+
+	void PointCloudLOD::draw(Renderer& renderer) const
+	{
+		renderer.drawPointRanges(m_vertexArray, m_drawFirst.data(), m_drawCount.data(), (int)m_drawFirst.size());
+		if (not m_pinned.empty())
+			renderer.drawPoints(m_vertexArray);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include "VertexArray.h"
+#include "VertexFormat.h"
+#include "Renderer.h"
+#include "Core/Base.h"
+
+namespace Core {
+
+	// Level of detail for large point clouds.
+	// Points are Morton sorted into chunks and every chunk is stored in bit-reversed order,
+	// so any prefix of a chunk is spread over the whole chunk. Each frame draws a prefix per
+	// chunk whose length keeps the expected gap between drawn points under `maxScreenError`
+	// pixels, plus the pinned points (hull vertices) at full rate.
+	class PointCloudLOD
+	{
+	public:
+		PointCloudLOD(const glm::vec3* points, size_t count, const QuantizationBounds& bounds,
+					  VertexFormat format = VertexFormat::Snorm16x4, int chunkSize = 1024);
+
+		// Indices into the original point array that are drawn every frame, each one once.
+		// Rewrites one index buffer in place, call it when the set changes rather than every frame
+		void setPinnedPoints(const unsigned int* indices, int count);
+		// pointToClip: original point coordinates to clip space
+		// projectionScale: projection[1][1] * viewport height / 2, pixels per unit at distance 1
+		void update(const glm::mat4& pointToClip, float projectionScale, float maxScreenError = 2.0f);
+		void draw(Renderer& renderer) const;
+
+		// The points in lod order, other vertex arrays can share it through getSlot()
+		Ref<VertexBuffer> getVertexBuffer() const { return m_vertexArray->getVertexBuffer(); }
+		unsigned int getSlot(unsigned int index) const { return m_slot[index]; }
+		size_t getPointCount() const { return m_order.size(); }
+		size_t getDrawnCount() const { return m_drawnCount; }
+
+	private:
+		struct Chunk
+		{
+			glm::vec3 center;
+			float radius;
+			int first;
+			int count;
+		};
+
+	private:
+		Ref<VertexArray> m_vertexArray;
+		std::vector<Chunk> m_chunks;
+		std::vector<unsigned int> m_order;      // lod slot -> original index
+		std::vector<unsigned int> m_slot;       // original index -> lod slot
+		std::vector<int> m_drawFirst;
+		std::vector<int> m_drawCount;
+		std::vector<unsigned int> m_pinned;
+		size_t m_drawnCount = 0;
+	};
+
+}
\ No newline at end of file
@@ -13,6 +13,10 @@ namespace Core {
 		glEnable(GL_LINE_SMOOTH);
 		glEnable(GL_BLEND);
 		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		m_cameraBuffer = createRef<UniformBuffer>(sizeof(glm::mat4), UniformBinding::CameraBinding);
+		m_modelBuffer = createRef<UniformBuffer>(sizeof(glm::mat4), UniformBinding::ModelBinding);
+		m_gpuTimer = createRef<GpuTimer>();
+		setModelTransform(glm::mat4(1.0f));
 	}
 
 	void Renderer::setViewport(int x, int y, size_t width, size_t height)
@@ -30,8 +34,23 @@ namespace Core {
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	}
 
+	void Renderer::beginScene(const glm::mat4& viewProjection)
+	{
+		m_gpuTimer->beginFrame();
+		if (viewProjection == m_viewProjection)
+			return;
+		m_viewProjection = viewProjection;
+		m_cameraBuffer->setData(&viewProjection, sizeof(glm::mat4));
+	}
+
+	void Renderer::setModelTransform(const glm::mat4& model)
+	{
+		m_modelBuffer->setData(&model, sizeof(glm::mat4));
+	}
+
 	void Renderer::drawPoints(const Ref<VertexArray>& pointArray, int count)
 	{
+		GpuTimerScope timer(*m_gpuTimer, GpuPass::Points);
 		pointArray->bind();
 		if (count == 0)
 			glDrawElements(GL_POINTS, pointArray->getIndexBuffer()->getCount(), GL_UNSIGNED_INT, nullptr);
@@ -39,8 +58,18 @@ namespace Core {
 			glDrawArrays(GL_POINTS, 0, count);
 	}
 
+	void Renderer::drawPointRanges(const Ref<VertexArray>& pointArray, const int* first, const int* count, int rangeCount)
+	{
+		if (rangeCount == 0)
+			return;
+		GpuTimerScope timer(*m_gpuTimer, GpuPass::Points);
+		pointArray->bind();
+		glMultiDrawArrays(GL_POINTS, first, count, rangeCount);
+	}
+
 	void Renderer::drawLines(const Ref<VertexArray>& lineArray, int count)
 	{
+		GpuTimerScope timer(*m_gpuTimer, GpuPass::Lines);
 		lineArray->bind();
 		if (count == 0)
 			glDrawElements(GL_LINES, lineArray->getIndexBuffer()->getCount(), GL_UNSIGNED_INT, nullptr);
@@ -50,6 +79,7 @@ namespace Core {
 
 	void Renderer::drawTriangles(const Ref<VertexArray>& triangleArray, int count)
 	{
+		GpuTimerScope timer(*m_gpuTimer, GpuPass::Triangles);
 		triangleArray->bind();
 		if (count == 0)
 			glDrawElements(GL_TRIANGLES, triangleArray->getIndexBuffer()->getCount(), GL_UNSIGNED_INT, nullptr);
@@ -57,6 +87,13 @@ namespace Core {
 			glDrawArrays(GL_TRIANGLES, 0, count);
 	}
 
+	void Renderer::drawTrianglesInstanced(const Ref<VertexArray>& triangleArray, int instanceCount)
+	{
+		GpuTimerScope timer(*m_gpuTimer, GpuPass::Triangles);
+		triangleArray->bind();
+		glDrawElementsInstanced(GL_TRIANGLES, triangleArray->getIndexBuffer()->getCount(), GL_UNSIGNED_INT, nullptr, instanceCount);
+	}
+
 	void Renderer::setPointSize(float size)
 	{
 		glPointSize(size);
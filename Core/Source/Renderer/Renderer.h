@@ -3,6 +3,8 @@
 #include "VertexArray.h"
 #include "Buffer.h"
 #include "Shader.h"
+#include "UniformBuffer.h"
+#include "GpuTimer.h"
 #include "Core/Base.h"
 
 namespace Core {
@@ -15,13 +17,29 @@ namespace Core {
 		void setViewport(int x, int y, size_t width, size_t height);
 		void setClearColor(const glm::vec4& color);
 		void clear();
+		// Starts a frame: uploads the camera block shared by every program
+		// and collects the GPU timings of an earlier frame
+		void beginScene(const glm::mat4& viewProjection);
+		// Model block shared by the point/line/triangle shaders, also undoes vertex quantization
+		void setModelTransform(const glm::mat4& model);
 
 		void drawPoints(const Ref<VertexArray>& pointArray, int count = 0);
+		// Several [first, first + count) runs of the vertex buffer in one call
+		void drawPointRanges(const Ref<VertexArray>& pointArray, const int* first, const int* count, int rangeCount);
 		void drawLines(const Ref<VertexArray>& lineArray, int count = 0);
 		void drawTriangles(const Ref<VertexArray>& triangleArray, int count = 0);
+		void drawTrianglesInstanced(const Ref<VertexArray>& triangleArray, int instanceCount);
 
 		void setPointSize(float size);
 		void setLineWidth(float width);
+
+		const GpuTimer& getGpuTimer() const { return *m_gpuTimer; }
+
+	private:
+		Ref<UniformBuffer> m_cameraBuffer;
+		Ref<UniformBuffer> m_modelBuffer;
+		Ref<GpuTimer> m_gpuTimer;
+		glm::mat4 m_viewProjection = glm::mat4(0.0f);
 	};
 
 }
\ No newline at end of file
@@ -1,5 +1,5 @@
 #include "Shader.h"
-#include <sstream>
+#include "ShaderCache.h"
 #include <fstream>
 #include <iostream>
 #include <glm/gtc/type_ptr.hpp>
@@ -16,12 +16,14 @@ namespace Core {
 	Shader::Shader(const std::string& vertexShaderSource, const std::string& fragmentShaderSource)
 	{
 		m_rendererId = createProgram(vertexShaderSource, fragmentShaderSource);
+		cacheUniformLocations();
 	}
 
 	Shader::Shader(const std::string& shaderPath) 
 	{
 		auto [vertexSource, fragmentSource] = getSource(shaderPath);
 		m_rendererId = createProgram(vertexSource, fragmentSource);
+		cacheUniformLocations();
 	}
 
 	Shader::~Shader()
@@ -48,29 +50,34 @@ namespace Core {
 
 	std::pair<std::string, std::string> Shader::getSource(const std::string& shaderPath) 
 	{
-		std::ifstream stream(shaderPath);
-		enum class shaderType {
-			NONE = -1, VERTEX = 0, FRAGMENT = 1
-		};
-		shaderType type = shaderType::NONE;
-
-		std::string line;
-		std::stringstream sstream[2];
-		while (std::getline(stream, line)) {
-			if (line.substr(0, 13) == "#vertexShader") 
-			{
-				type = shaderType::VERTEX;
-			}
-			else if (line.substr(0, 15) == "#fragmentShader") 
-			{
-				type = shaderType::FRAGMENT;
-			}
-			else if (type != shaderType::NONE) 
-			{
-				sstream[int(type)] << line << '\n';
-			}
+		// One read of the whole file, then split at the stage markers
+		std::ifstream stream(shaderPath, std::ios::binary);
+		std::string source;
+		if (stream)
+		{
+			stream.seekg(0, std::ios::end);
+			source.resize((size_t)stream.tellg());
+			stream.seekg(0, std::ios::beg);
+			stream.read(&source[0], (std::streamsize)source.size());
 		}
-		return std::pair(sstream[0].str(), sstream[1].str());
+
+		// Markers only count at the start of a line
+		auto find = [&source](const char* marker) {
+			size_t pos = source.find(marker);
+			while (pos != std::string::npos && pos != 0 && source[pos - 1] != '\n')
+				pos = source.find(marker, pos + 1);
+			return pos;
+		};
+		size_t vertexMarker = find("#vertexShader");
+		size_t fragmentMarker = find("#fragmentShader");
+		auto stage = [&source](size_t marker, size_t nextMarker) {
+			size_t begin = marker == std::string::npos ? marker : source.find('\n', marker);
+			if (begin == std::string::npos)
+				return std::string();
+			size_t end = nextMarker > marker ? nextMarker : source.size();
+			return source.substr(begin + 1, std::min(end, source.size()) - begin - 1);
+		};
+		return std::pair(stage(vertexMarker, fragmentMarker), stage(fragmentMarker, vertexMarker));
 	}
 
 	unsigned int Shader::compileShader(unsigned int type, const std::string& source) 
@@ -94,12 +101,17 @@ namespace Core {
 
 	unsigned int Shader::createProgram(const std::string& vertexShaderSource, const std::string& fragmentShaderSource) 
 	{
+		uint64_t cacheKey = ShaderCache::computeKey(vertexShaderSource, fragmentShaderSource);
+		if (unsigned int cachedProgram = ShaderCache::loadProgram(cacheKey))
+			return cachedProgram;
+
 		unsigned int shaderProgram = glCreateProgram();
 		unsigned int vertexShader = compileShader(GL_VERTEX_SHADER, vertexShaderSource);
 		unsigned int fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
 
 		glAttachShader(shaderProgram, vertexShader);
 		glAttachShader(shaderProgram, fragmentShader);
+		glProgramParameteri(shaderProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 		glLinkProgram(shaderProgram);
 
 		int success;
@@ -113,6 +125,8 @@ namespace Core {
 		glDeleteShader(vertexShader);
 		glDeleteShader(fragmentShader);
 		glValidateProgram(shaderProgram);
+		if (success)
+			ShaderCache::storeProgram(cacheKey, shaderProgram);
 		return shaderProgram;
 	}
 
@@ -128,6 +142,38 @@ namespace Core {
 		return m_uniformLocationCache[name] = location;
 	}
 
+	void Shader::cacheUniformLocations()
+	{
+		// Resolve every active uniform up front, members of uniform blocks report -1 and are skipped
+		int count = 0;
+		int maxLength = 0;
+		glGetProgramiv(m_rendererId, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(m_rendererId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+		std::string name(maxLength, '\0');
+		for (int i = 0; i < count; i++)
+		{
+			int length = 0, size = 0;
+			GLenum type;
+			glGetActiveUniform(m_rendererId, i, maxLength, &length, &size, &type, &name[0]);
+			std::string uniformName = name.substr(0, length);
+			int location = glGetUniformLocation(m_rendererId, uniformName.c_str());
+			if (location == -1)
+				continue;
+			m_uniformLocationCache[uniformName] = location;
+			// Arrays are reported once as "name[0]", make the plain name and every element reachable
+			if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0)
+			{
+				std::string baseName = uniformName.substr(0, uniformName.size() - 3);
+				m_uniformLocationCache[baseName] = location;
+				for (int element = 1; element < size; element++)
+				{
+					std::string elementName = baseName + "[" + std::to_string(element) + "]";
+					m_uniformLocationCache[elementName] = glGetUniformLocation(m_rendererId, elementName.c_str());
+				}
+			}
+		}
+	}
+
 	void Shader::setUniform1i(const std::string& name, int v0) 
 	{
 		ENSURE_SHADER_BOUND;
@@ -146,4 +192,34 @@ namespace Core {
 		glUniformMatrix4fv(getUniformLocation(name), 1, GL_FALSE, glm::value_ptr(matrix));
 	}
 
+	void Shader::setUniform(Uniform<int> uniform, int v0)
+	{
+		ENSURE_SHADER_BOUND;
+		glUniform1i(uniform.location, v0);
+	}
+
+	void Shader::setUniform(Uniform<float> uniform, float v0)
+	{
+		ENSURE_SHADER_BOUND;
+		glUniform1f(uniform.location, v0);
+	}
+
+	void Shader::setUniform(Uniform<glm::vec3> uniform, const glm::vec3& vec)
+	{
+		ENSURE_SHADER_BOUND;
+		glUniform3fv(uniform.location, 1, glm::value_ptr(vec));
+	}
+
+	void Shader::setUniform(Uniform<glm::vec4> uniform, const glm::vec4& vec)
+	{
+		ENSURE_SHADER_BOUND;
+		glUniform4fv(uniform.location, 1, glm::value_ptr(vec));
+	}
+
+	void Shader::setUniform(Uniform<glm::mat4> uniform, const glm::mat4& matrix)
+	{
+		ENSURE_SHADER_BOUND;
+		glUniformMatrix4fv(uniform.location, 1, GL_FALSE, glm::value_ptr(matrix));
+	}
+
 }
\ No newline at end of file
@@ -11,6 +11,13 @@ namespace Core {
 #define SHADER_CFUNC
 #endif // DEBUG
 
+	// Typed handle to a uniform, resolved once when the owner is created
+	// so the per-frame setters never touch the location cache.
+	template<typename T>
+	struct Uniform
+	{
+		int location = -1;
+	};
 
 	class Shader
 	{
@@ -28,12 +35,25 @@ namespace Core {
 
 	private:
 		int getUniformLocation(const std::string& name);
+		void cacheUniformLocations();
 
 	public:
 		void setUniform1i(const std::string& name, int v0);
 		void setUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
 		void setUniformMat4f(const std::string& name, const glm::mat4& matrix);
 
+		template<typename T>
+		Uniform<T> getUniform(const std::string& name) const
+		{
+			auto it = m_uniformLocationCache.find(name);
+			return { it != m_uniformLocationCache.end() ? it->second : -1 };
+		}
+
+		void setUniform(Uniform<int> uniform, int v0);
+		void setUniform(Uniform<float> uniform, float v0);
+		void setUniform(Uniform<glm::vec3> uniform, const glm::vec3& vec);
+		void setUniform(Uniform<glm::vec4> uniform, const glm::vec4& vec);
+		void setUniform(Uniform<glm::mat4> uniform, const glm::mat4& matrix);
 
 	private:
 		unsigned int m_rendererId;
@@ -0,0 +1,148 @@
+#include "ShaderCache.h"
+#include "Shader.h"
+#include <cstdio>
+#include <vector>
+#include <filesystem>
+
+namespace Core {
+
+	std::string ShaderCache::s_directory = "Cache/Shader";
+	std::unordered_map<uint64_t, std::weak_ptr<Shader>> ShaderLibrary::s_shaders;
+
+	namespace {
+		constexpr uint32_t s_binaryMagic = 0x42534843; // "CHSB"
+
+		struct BinaryHeader
+		{
+			uint32_t magic;
+			uint32_t format;
+			uint32_t length;
+		};
+
+		// FNV-1a, the sources are hashed once per program creation
+		uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 14695981039346656037ull)
+		{
+			const unsigned char* bytes = static_cast<const unsigned char*>(data);
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+	}
+
+	uint64_t ShaderCache::computeKey(const std::string& vertexShaderSource, const std::string& fragmentShaderSource)
+	{
+		const std::string& driver = getDriverString();
+		uint64_t hash = hashBytes(driver.data(), driver.size());
+		hash = hashBytes(vertexShaderSource.data(), vertexShaderSource.size() + 1, hash);
+		return hashBytes(fragmentShaderSource.data(), fragmentShaderSource.size(), hash);
+	}
+
+	unsigned int ShaderCache::loadProgram(uint64_t key)
+	{
+		if (not isSupported())
+			return 0;
+		FILE* file = std::fopen(getPath(key).c_str(), "rb");
+		if (file == nullptr)
+			return 0;
+
+		BinaryHeader header{};
+		std::vector<char> binary;
+		bool valid = std::fread(&header, sizeof(header), 1, file) == 1 && header.magic == s_binaryMagic;
+		if (valid)
+		{
+			binary.resize(header.length);
+			valid = std::fread(binary.data(), 1, binary.size(), file) == binary.size();
+		}
+		std::fclose(file);
+		if (not valid)
+			return 0;
+
+		unsigned int program = glCreateProgram();
+		glProgramBinary(program, header.format, binary.data(), (GLsizei)binary.size());
+		int success;
+		glGetProgramiv(program, GL_LINK_STATUS, &success);
+		if (not success)
+		{
+			// Rejected by the driver (e.g. after an update with the same version string)
+			glDeleteProgram(program);
+			return 0;
+		}
+		return program;
+	}
+
+	void ShaderCache::storeProgram(uint64_t key, unsigned int program)
+	{
+		if (not isSupported())
+			return;
+		int length = 0;
+		glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
+
+		std::vector<char> binary(length);
+		GLenum format = 0;
+		glGetProgramBinary(program, length, &length, &format, binary.data());
+
+		std::error_code error;
+		std::filesystem::create_directories(s_directory, error);
+		FILE* file = std::fopen(getPath(key).c_str(), "wb");
+		if (file == nullptr)
+			return;
+		BinaryHeader header{ s_binaryMagic, format, (uint32_t)length };
+		std::fwrite(&header, sizeof(header), 1, file);
+		std::fwrite(binary.data(), 1, length, file);
+		std::fclose(file);
+	}
+
+	bool ShaderCache::isSupported()
+	{
+		static const bool supported = [] {
+			int formats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+			return formats > 0;
+		}();
+		return supported;
+	}
+
+	std::string ShaderCache::getPath(uint64_t key)
+	{
+		char name[24];
+		std::snprintf(name, sizeof(name), "%016llx.bin", (unsigned long long)key);
+		return s_directory + "/" + name;
+	}
+
+	const std::string& ShaderCache::getDriverString()
+	{
+		static const std::string driver = [] {
+			std::string result;
+			for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+			{
+				const char* value = (const char*)glGetString(name);
+				result += value ? value : "";
+				result += '\n';
+			}
+			return result;
+		}();
+		return driver;
+	}
+
+	Ref<Shader> ShaderLibrary::load(const std::string& shaderPath)
+	{
+		auto [vertexSource, fragmentSource] = Shader::getSource(shaderPath);
+		return load(vertexSource, fragmentSource);
+	}
+
+	Ref<Shader> ShaderLibrary::load(const std::string& vertexShaderSource, const std::string& fragmentShaderSource)
+	{
+		std::weak_ptr<Shader>& entry = s_shaders[ShaderCache::computeKey(vertexShaderSource, fragmentShaderSource)];
+		if (Ref<Shader> shader = entry.lock())
+			return shader;
+		Ref<Shader> shader = createRef<Shader>(vertexShaderSource, fragmentShaderSource);
+		entry = shader;
+		return shader;
+	}
+
+}
\ No newline at end of file
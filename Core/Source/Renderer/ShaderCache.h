@@ -0,0 +1,48 @@
+#pragma once
+#include <glad/glad.h>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+#include "Core/Base.h"
+
+namespace Core {
+
+	class Shader;
+
+	// On-disk cache of linked program binaries (glGetProgramBinary/glProgramBinary).
+	// Entries are keyed by a hash of both sources and the driver string, so a driver
+	// update simply misses the cache and the program is compiled from source again.
+	class ShaderCache
+	{
+	public:
+		static void setDirectory(const std::string& directory) { s_directory = directory; }
+		static const std::string& getDirectory() { return s_directory; }
+
+		static uint64_t computeKey(const std::string& vertexShaderSource, const std::string& fragmentShaderSource);
+		// Returns 0 when there is no usable binary for this key
+		static unsigned int loadProgram(uint64_t key);
+		// The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+		static void storeProgram(uint64_t key, unsigned int program);
+		static bool isSupported();
+
+	private:
+		static std::string getPath(uint64_t key);
+		static const std::string& getDriverString();
+
+	private:
+		static std::string s_directory;
+	};
+
+	// Shares one program between every user asking for the same sources.
+	// Uniform values live in the program, so users must set theirs before each draw.
+	class ShaderLibrary
+	{
+	public:
+		static Ref<Shader> load(const std::string& shaderPath);
+		static Ref<Shader> load(const std::string& vertexShaderSource, const std::string& fragmentShaderSource);
+
+	private:
+		static std::unordered_map<uint64_t, std::weak_ptr<Shader>> s_shaders;
+	};
+
+}
\ No newline at end of file
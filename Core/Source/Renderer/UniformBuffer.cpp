@@ -0,0 +1,32 @@
+#include "UniformBuffer.h"
+
+namespace Core {
+
+	UniformBuffer::UniformBuffer(size_t size, unsigned int binding)
+		: m_binding(binding)
+	{
+		glGenBuffers(1, &m_rendererId);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_rendererId);
+		glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		// Bound once, every program declaring the block at this binding reads from it
+		glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_rendererId);
+	}
+
+	UniformBuffer::~UniformBuffer()
+	{
+		glDeleteBuffers(1, &m_rendererId);
+	}
+
+	void UniformBuffer::setData(const void* data, size_t size, size_t offset)
+	{
+		glBindBuffer(GL_UNIFORM_BUFFER, m_rendererId);
+		glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+		BufferStats::record(size);
+	}
+
+	UniformBuffer* UniformBuffer::create(size_t size, unsigned int binding)
+	{
+		return new UniformBuffer(size, binding);
+	}
+
+}
\ No newline at end of file
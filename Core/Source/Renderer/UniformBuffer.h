@@ -0,0 +1,31 @@
+#pragma once
+#include <glad/glad.h>
+#include <cstddef>
+#include "Buffer.h"
+
+namespace Core {
+
+	// Binding points shared with the `layout (std140, binding = N)` blocks in the shaders
+	enum UniformBinding : unsigned int
+	{
+		CameraBinding = 0,
+		ModelBinding = 1,
+	};
+
+	class UniformBuffer
+	{
+	public:
+		UniformBuffer(size_t size, unsigned int binding);
+		~UniformBuffer();
+
+		void setData(const void* data, size_t size, size_t offset = 0);
+		unsigned int getBinding() const { return m_binding; }
+
+		static UniformBuffer* create(size_t size, unsigned int binding);
+
+	private:
+		unsigned int m_rendererId;
+		unsigned int m_binding;
+	};
+
+}
\ No newline at end of file
@@ -38,7 +38,7 @@ namespace Core {
 				vertexBuffer->getLayout().getStride(), 
 				(const void*)offset
 			);
-			offset += element.count * BufferElement::sizeOfType(element.type);
+			offset += element.getSize();
 		}
 		m_vertexBuffer = vertexBuffer;
 	}
@@ -0,0 +1,86 @@
+#include "VertexFormat.h"
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cstring>
+#include <cstdint>
+
+namespace Core {
+
+	QuantizationBounds QuantizationBounds::fromPoints(const glm::vec3* points, size_t count)
+	{
+		QuantizationBounds bounds;
+		if (count == 0)
+			return bounds;
+		glm::vec3 lo = points[0];
+		glm::vec3 hi = points[0];
+		for (size_t i = 1; i < count; i++)
+		{
+			lo = glm::min(lo, points[i]);
+			hi = glm::max(hi, points[i]);
+		}
+		bounds.center = 0.5f * (lo + hi);
+		bounds.extent = glm::max(0.5f * (hi - lo), glm::vec3(1e-6f));
+		return bounds;
+	}
+
+	glm::mat4 QuantizationBounds::getDequantization() const
+	{
+		return glm::scale(glm::translate(glm::mat4(1.0f), center), extent);
+	}
+
+	BufferElement getPositionElement(VertexFormat format)
+	{
+		switch (format)
+		{
+		case VertexFormat::Float3: return { 3, GL_FLOAT, GL_FALSE };
+		case VertexFormat::Half4: return { 4, GL_HALF_FLOAT, GL_FALSE };
+		case VertexFormat::Snorm16x4: return { 4, GL_SHORT, GL_TRUE };
+		case VertexFormat::Snorm10x3: return { 4, GL_INT_2_10_10_10_REV, GL_TRUE };
+		}
+		assert(false && "unknown vertex format");
+		return { 3, GL_FLOAT, GL_FALSE };
+	}
+
+	size_t getVertexSize(VertexFormat format)
+	{
+		return getPositionElement(format).getSize();
+	}
+
+	void quantizePositions(VertexFormat format, const glm::vec3* points, size_t count,
+						   const QuantizationBounds& bounds, void* destination)
+	{
+		unsigned char* out = static_cast<unsigned char*>(destination);
+		switch (format)
+		{
+		case VertexFormat::Float3:
+			for (size_t i = 0; i < count; i++, out += sizeof(glm::vec3))
+			{
+				glm::vec3 normalized = bounds.quantize(points[i]);
+				std::memcpy(out, &normalized, sizeof(normalized));
+			}
+			break;
+		case VertexFormat::Half4:
+			for (size_t i = 0; i < count; i++, out += sizeof(uint64_t))
+			{
+				uint64_t packed = glm::packHalf4x16(glm::vec4(bounds.quantize(points[i]), 1.0f));
+				std::memcpy(out, &packed, sizeof(packed));
+			}
+			break;
+		case VertexFormat::Snorm16x4:
+			for (size_t i = 0; i < count; i++, out += sizeof(uint64_t))
+			{
+				uint64_t packed = glm::packSnorm4x16(glm::vec4(bounds.quantize(points[i]), 1.0f));
+				std::memcpy(out, &packed, sizeof(packed));
+			}
+			break;
+		case VertexFormat::Snorm10x3:
+			for (size_t i = 0; i < count; i++, out += sizeof(uint32_t))
+			{
+				uint32_t packed = glm::packSnorm3x10_1x2(glm::vec4(bounds.quantize(points[i]), 1.0f));
+				std::memcpy(out, &packed, sizeof(packed));
+			}
+			break;
+		}
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstddef>
+#include "Buffer.h"
+
+namespace Core {
+
+	// Storage formats for positions, all of them hold positions normalized to the cloud bounds
+	enum class VertexFormat
+	{
+		Float3,         // 12 bytes, full precision
+		Half4,          // 8 bytes, half floats in [-1, 1]
+		Snorm16x4,      // 8 bytes, normalized int16
+		Snorm10x3       // 4 bytes, packed 10-10-10-2
+	};
+
+	// Axis aligned bounds of a point cloud, maps it into [-1, 1]^3 for the compact formats
+	struct QuantizationBounds
+	{
+		glm::vec3 center = glm::vec3(0.0f);
+		glm::vec3 extent = glm::vec3(1.0f); // half size, never zero
+
+		static QuantizationBounds fromPoints(const glm::vec3* points, size_t count);
+
+		glm::vec3 quantize(const glm::vec3& point) const { return (point - center) / extent; }
+		// Model matrix taking decoded attributes back to the original positions
+		glm::mat4 getDequantization() const;
+	};
+
+	BufferElement getPositionElement(VertexFormat format);
+	size_t getVertexSize(VertexFormat format);
+
+	// Writes `count` positions in `format` to `destination`, which may be a mapped buffer
+	void quantizePositions(VertexFormat format, const glm::vec3* points, size_t count,
+						   const QuantizationBounds& bounds, void* destination);
+
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include <array>
+#include <cstdio>
+#include <random>
+#include <span>
+#include <vector>
+#include "Math/Hull.h"
+
+using namespace Core;
+
+namespace {
+
+	template<int D>
+	using Point = std::array<double, D>;
+
+	// Closed facet links, no point outside and the vertices of a fresh build()
+	template<int D>
+	bool matches(const Hull<D, double>& kinetic, const Hull<D, double>& fresh, const std::vector<Point<D>>& points)
+	{
+		const auto& facets = kinetic.facets();
+		for (uint32_t f = 0; f < uint32_t(facets.size()); f++)
+		{
+			for (uint32_t nb : facets[f].neighbors)
+			{
+				if (nb >= facets.size())
+					return false;
+				bool back = false;
+				for (uint32_t g : facets[nb].neighbors)
+					back = back || g == f;
+				if (not back)
+					return false;
+			}
+			for (const auto& q : points)
+			{
+				double distance = facets[f].offset;
+				for (int k = 0; k < D; k++)
+					distance += facets[f].normal[k] * q[k];
+				if (distance > 1e-9)
+					return false;
+			}
+		}
+		return kinetic.vertices() == fresh.vertices();
+	}
+
+	// Gaussian clouds jittered over a few frames, update() must agree with build() every frame
+	template<int D>
+	int run(int count, double jitter, int seeds, int frames)
+	{
+		int failures = 0;
+		for (int seed = 0; seed < seeds; seed++)
+		{
+			std::mt19937 rng(seed);
+			std::normal_distribution<double> gauss;
+			std::vector<Point<D>> points(count);
+			for (auto& q : points)
+				for (double& x : q)
+					x = gauss(rng);
+
+			Hull<D, double> kinetic, fresh;
+			kinetic.build(std::span<const Point<D>>(points));
+			for (int frame = 0; frame < frames; frame++)
+			{
+				for (auto& q : points)
+					for (double& x : q)
+						x += jitter * gauss(rng);
+				kinetic.update(std::span<const Point<D>>(points));
+				fresh.build(std::span<const Point<D>>(points));
+				if (not matches<D>(kinetic, fresh, points))
+				{
+					std::printf("FAIL %dD count %d jitter %g seed %d frame %d rebuilt %d\n",
+						D, count, jitter, seed, frame, int(kinetic.getLastUpdate().rebuilt));
+					failures++;
+					break;
+				}
+			}
+		}
+		return failures;
+	}
+
+}
+
+int main()
+{
+	int failures = 0;
+	for (int count : { 50, 300, 2000 })
+	{
+		for (double jitter : { 0.001, 0.02, 0.05, 0.2 })
+		{
+			failures += run<3>(count, jitter, 20, 5);
+			failures += run<4>(count, jitter, 20, 5);
+		}
+	}
+	std::printf(failures == 0 ? "Hull::update matches Hull::build\n" : "%d failing runs\n", failures);
+	return failures == 0 ? 0 : 1;
+}
\ No newline at end of file